@@ -50,6 +50,7 @@ pqProgressManager::pqProgressManager(QObject* _parent)
 
   this->EnableProgress = false;
   this->ReadyEnableProgress = false;
+  this->EnableAbort = false;
   this->LastProgressTime = 0;
 
   this->VTKConnect = vtkEventQtSlotConnect::New();
@@ -61,6 +62,8 @@ pqProgressManager::pqProgressManager(QObject* _parent)
     this, SLOT(onEndProgress()));
   this->VTKConnect->Connect(pm, vtkCommand::ProgressEvent,
     this, SLOT(onProgress()));
+
+  QObject::connect(this, SIGNAL(abort()), this, SLOT(onAbort()));
 }
 
 //-----------------------------------------------------------------------------
@@ -192,6 +195,11 @@ void pqProgressManager::onStartProgress()
 void pqProgressManager::onEndProgress()
 {
   this->ReadyEnableProgress = false;
+  if (this->EnableAbort)
+    {
+    this->EnableAbort = false;
+    this->setEnableAbort(false);
+    }
   if (this->EnableProgress)
     {
     this->setEnableProgress(false);
@@ -199,6 +207,17 @@ void pqProgressManager::onEndProgress()
   this->EnableProgress = false;
 }
 
+//-----------------------------------------------------------------------------
+void pqProgressManager::onAbort()
+{
+  // When locked, the abort is meant for the object holding the lock, e.g.
+  // the animation being saved.
+  if (this->EnableAbort && !this->Lock)
+    {
+    vtkProcessModule::GetProcessModule()->AbortExecution();
+    }
+}
+
 //-----------------------------------------------------------------------------
 void pqProgressManager::onProgress()
 {
@@ -237,6 +256,11 @@ void pqProgressManager::onProgress()
     {
     this->EnableProgress = true;
     this->setEnableProgress(true);
+    if (!this->Lock)
+      {
+      this->EnableAbort = true;
+      this->setEnableAbort(true);
+      }
     }
 
   this->LastProgressTime = lastprog;
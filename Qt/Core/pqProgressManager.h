@@ -44,6 +44,8 @@ class vtkEventQtSlotConnect;
 /// only progress fired by itself will be notified to the rest of the world.
 /// Also, when progress is enabled, it disables handling of mouse/key events 
 /// except on those objects in the NonBlockableObjects list.
+/// While the progress of a pipeline execution is shown, abort is enabled and
+/// abort() aborts the execution through vtkProcessModule::AbortExecution().
 class PQCORE_EXPORT pqProgressManager : public QObject
 {
   Q_OBJECT
@@ -113,6 +115,9 @@ protected slots:
   void onEndProgress();
   void onProgress();
 
+  /// called when abort() is fired to abort the pipeline execution, if any.
+  void onAbort();
+
 protected:
   QPointer<QObject> Lock;
   QList<QPointer<QObject> > NonBlockableObjects;
@@ -122,6 +127,7 @@ protected:
   double LastProgressTime;
   bool EnableProgress;
   bool ReadyEnableProgress;
+  bool EnableAbort; // abort enabled for the pipeline execution.
   vtkEventQtSlotConnect* VTKConnect;
 private:
   pqProgressManager(const pqProgressManager&); // Not implemented.
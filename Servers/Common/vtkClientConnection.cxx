@@ -16,6 +16,7 @@
 
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerStream.h"
+#include "vtkCommand.h"
 #include "vtkInstantiator.h"
 #include "vtkObjectFactory.h"
 #include "vtkProcessModule.h"
@@ -30,6 +31,7 @@
 
 #include <vtkstd/new>
 #include <vtkstd/string>
+#include <vtkstd/vector>
 
 //-----------------------------------------------------------------------------
 // RMI Callbacks.
@@ -357,6 +359,9 @@ void vtkClientConnection::SetupRMIs()
   if (comm)
     {
     comm->SetReportErrors(0);
+    // Abort requests from the client are received here when they arrive
+    // after the execution they were meant for.
+    comm->AddObserver(vtkCommand::WrongTagEvent, this->GetObserver());
     }
 }
 
@@ -400,14 +405,13 @@ void vtkClientConnection::SendInformation(vtkClientServerStream& stream)
     
     vtkClientServerStream css;
     info->CopyToStream(&css);
-    size_t length;
-    const unsigned char* data;
-    css.GetData(&data, &length);
-    int len = static_cast<int>(length);
+    vtkstd::vector<unsigned char> buffer;
+    vtkRemoteConnection::EncodeInformation(css, buffer);
+    int len = static_cast<int>(buffer.size());
     this->GetSocketController()->Send(&len, 1, 1,
       vtkRemoteConnection::ROOT_INFORMATION_LENGTH_TAG);
-    this->GetSocketController()->Send(const_cast<unsigned char*>(data),
-      length, 1, vtkRemoteConnection::ROOT_INFORMATION_TAG);
+    this->GetSocketController()->Send(&buffer[0],
+      buffer.size(), 1, vtkRemoteConnection::ROOT_INFORMATION_TAG);
     }
   else
     {
@@ -46,9 +46,11 @@
 #endif
 
 #include <vtksys/SystemTools.hxx>
-#include <vtksys/RegularExpression.hxx>
+#include <vtkstd/list>
 #include <vtkstd/set>
 #include <vtkstd/string>
+#include <vtkstd/vector>
+#include <time.h>
 
 vtkStandardNewMacro(vtkPVFileInformation);
 vtkCxxRevisionMacro(vtkPVFileInformation, "$Revision$");
@@ -836,6 +838,91 @@ void vtkPVFileInformation::GetWindowsDirectoryListing()
 #endif
 }
 
+#if !defined(_WIN32)
+//-----------------------------------------------------------------------------
+// Listings of the last directories listed, reused as long as the directory
+// is not modified, so that browsing back and forth in the file dialog does
+// not list and group large directories again. Plain data is kept rather than
+// vtkPVFileInformation objects so that nothing VTK is alive at exit.
+class vtkPVFileInformationListingCache
+{
+public:
+  struct Item
+    {
+    vtkstd::string Name;
+    int Type;
+    vtkstd::vector<vtkstd::pair<vtkstd::string, int> > Children;
+    };
+
+  struct Listing
+    {
+    vtkstd::string Path;
+    int FastFileTypeDetection;
+    dev_t Device;
+    ino_t Inode;
+    time_t ModifiedTime;
+    vtkstd::vector<Item> Items;
+    size_t Size;
+    };
+
+  // Most recently used first.
+  vtkstd::list<Listing> Listings;
+
+  // Number of entries kept over all listings.
+  enum { MAXIMUM_SIZE = 1 << 20 };
+
+  Listing* Find(const char* path, int fast, const struct stat& info)
+    {
+    vtkstd::list<Listing>::iterator iter;
+    for (iter = this->Listings.begin(); iter != this->Listings.end(); ++iter)
+      {
+      if (iter->Path == path && iter->FastFileTypeDetection == fast)
+        {
+        if (iter->Device != info.st_dev || iter->Inode != info.st_ino ||
+          iter->ModifiedTime != info.st_mtime)
+          {
+          this->Listings.erase(iter);
+          return 0;
+          }
+        this->Listings.splice(this->Listings.begin(), this->Listings, iter);
+        return &this->Listings.front();
+        }
+      }
+    return 0;
+    }
+
+  Listing& Add(const char* path, int fast, const struct stat& info)
+    {
+    this->Listings.push_front(Listing());
+    Listing& listing = this->Listings.front();
+    listing.Path = path;
+    listing.FastFileTypeDetection = fast;
+    listing.Device = info.st_dev;
+    listing.Inode = info.st_ino;
+    listing.ModifiedTime = info.st_mtime;
+    listing.Size = 0;
+    return listing;
+    }
+
+  void Prune()
+    {
+    size_t size = 0;
+    vtkstd::list<Listing>::iterator iter = this->Listings.begin();
+    for (; iter != this->Listings.end(); ++iter)
+      {
+      size += iter->Size;
+      if (size > MAXIMUM_SIZE)
+        {
+        this->Listings.erase(iter, this->Listings.end());
+        break;
+        }
+      }
+    }
+};
+
+static vtkPVFileInformationListingCache vtkPVFileInformationListings;
+#endif
+
 /* There is a problem with the Portland compiler, large file
 support and glibc/Linux system headers: 
              http://www.pgroup.com/userforum/viewtopic.php?
@@ -859,6 +946,45 @@ void vtkPVFileInformation::GetDirectoryListing()
   vtkstd::string prefix = this->FullPath;
   vtkPVFileInformationAddTerminatingSlash(prefix);
 
+  // A listing is cached only if the directory was last modified before the
+  // current second, otherwise a change later in that second would not be
+  // noticed.
+  time_t now = time(0);
+  struct stat dirInfo;
+  bool cacheable = stat(this->FullPath, &dirInfo) == 0 &&
+    now > dirInfo.st_mtime + 1;
+  if (cacheable)
+    {
+    vtkPVFileInformationListingCache::Listing* listing =
+      vtkPVFileInformationListings.Find(this->FullPath,
+        this->FastFileTypeDetection, dirInfo);
+    if (listing)
+      {
+      for (size_t cc=0; cc < listing->Items.size(); cc++)
+        {
+        const vtkPVFileInformationListingCache::Item& item = listing->Items[cc];
+        vtkPVFileInformation* info = vtkPVFileInformation::New();
+        info->SetName(item.Name.c_str());
+        info->SetFullPath((prefix + item.Name).c_str());
+        info->Type = item.Type;
+        info->FastFileTypeDetection = this->FastFileTypeDetection;
+        for (size_t kk=0; kk < item.Children.size(); kk++)
+          {
+          vtkPVFileInformation* child = vtkPVFileInformation::New();
+          child->SetName(item.Children[kk].first.c_str());
+          child->SetFullPath((prefix + item.Children[kk].first).c_str());
+          child->Type = item.Children[kk].second;
+          child->FastFileTypeDetection = this->FastFileTypeDetection;
+          info->Contents->AddItem(child);
+          child->Delete();
+          }
+        this->Contents->AddItem(info);
+        info->Delete();
+        }
+      return;
+      }
+    }
+
   // Open the directory and make sure it exists.
   DIR* dir = opendir(this->FullPath);
   if(!dir)
@@ -879,6 +1005,19 @@ void vtkPVFileInformation::GetDirectoryListing()
     info->SetName(d->d_name);
     info->SetFullPath((prefix + d->d_name).c_str());
     info->Type = INVALID;
+#if defined(DT_DIR) && defined(DT_REG)
+    // Use the type given by the directory entry when available, saving the
+    // stat calls in DetectType(). Links and unknown types are still resolved
+    // there.
+    if (d->d_type == DT_DIR)
+      {
+      info->Type = DIRECTORY;
+      }
+    else if (d->d_type == DT_REG)
+      {
+      info->Type = SINGLE_FILE;
+      }
+#endif
     info->FastFileTypeDetection = this->FastFileTypeDetection;
     info_set.insert(info);
     info->Delete();
@@ -912,6 +1051,33 @@ void vtkPVFileInformation::GetDirectoryListing()
         }
       }
     }
+
+  if (cacheable)
+    {
+    vtkPVFileInformationListingCache::Listing& listing =
+      vtkPVFileInformationListings.Add(this->FullPath,
+        this->FastFileTypeDetection, dirInfo);
+    int numItems = this->Contents->GetNumberOfItems();
+    listing.Items.resize(numItems);
+    for (int cc=0; cc < numItems; cc++)
+      {
+      vtkPVFileInformation* obj = vtkPVFileInformation::SafeDownCast(
+        this->Contents->GetItemAsObject(cc));
+      vtkPVFileInformationListingCache::Item& item = listing.Items[cc];
+      item.Name = obj->Name;
+      item.Type = obj->Type;
+      int numChildren = obj->Contents->GetNumberOfItems();
+      for (int kk=0; kk < numChildren; kk++)
+        {
+        vtkPVFileInformation* child = vtkPVFileInformation::SafeDownCast(
+          obj->Contents->GetItemAsObject(kk));
+        item.Children.push_back(
+          vtkstd::pair<vtkstd::string, int>(child->Name, child->Type));
+        }
+      listing.Size += 1 + numChildren;
+      }
+    vtkPVFileInformationListings.Prune();
+    }
 #endif
 }
 
@@ -967,6 +1133,140 @@ struct vtkPVFileInformation::vtkInfo
 
 };
 
+//-----------------------------------------------------------------------------
+inline bool vtkPVFileInformationIsNumeric(char c)
+{
+  return (c >= '0' && c <= '9') || c == '.';
+}
+
+inline bool vtkPVFileInformationIsAlpha(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+inline bool vtkPVFileInformationIsSeparator(char c)
+{
+  return c == '.' || c == '_' || c == '-';
+}
+
+//-----------------------------------------------------------------------------
+// Determines the name of the file series a file belongs to and its index in
+// the series. The result is the same as that of trying the following regular
+// expressions in order, but it takes a couple of linear scans of the name,
+// which matters for directories with many files:
+// \li sequence ending with numbers: "^(.*)\.([0-9.]+)$", name "\1".
+// \li sequence ending with extension: "^(.*)(\.|_|-)([0-9.]+)\.(.*)$",
+// name "\1\2..\4".
+// \li same with no ". _ or -" before the series number:
+// "^(.*)([a-zA-Z])([0-9.]+)\.(.*)$", name "\1\2..\4".
+// \li sequence starting with the series number followed by ". _ or -":
+// "^([0-9.]+)(\.|_|-)(.*)\.(.*)$", name "..\2\3.\4".
+// \li same without ". _ or -": "^([0-9.]+)([a-zA-Z])(.*)\.(.*)$",
+// name "..\2\3.\4".
+// \li fallback, the last number in the middle of the name:
+// "^(.*[^0-9])([0-9]+)([^0-9]+)$", name "\1..\3".
+static bool vtkPVFileInformationGetSeriesName(const char* cname,
+  vtkstd::string& groupName, int& groupIndex)
+{
+  const vtkstd::string name = cname? cname : "";
+  int n = static_cast<int>(name.size());
+  if (n == 0)
+    {
+    return false;
+    }
+
+  // numEnd[k] is the end of the run of [0-9.] starting at k and prevDot[k]
+  // the position of the last '.' at or before k (-1 if none).
+  vtkstd::vector<int> numEnd(n+1);
+  vtkstd::vector<int> prevDot(n);
+  numEnd[n] = n;
+  for (int k = n-1; k >= 0; --k)
+    {
+    numEnd[k] = vtkPVFileInformationIsNumeric(name[k])? numEnd[k+1] : k;
+    }
+  for (int k = 0; k < n; ++k)
+    {
+    prevDot[k] = (name[k] == '.')? k : (k > 0? prevDot[k-1] : -1);
+    }
+
+  // "^(.*)\.([0-9.]+)$": the last '.' followed only by [0-9.].
+  if (n >= 2 && prevDot[n-2] >= 0 && numEnd[prevDot[n-2]+1] == n)
+    {
+    int dot = prevDot[n-2];
+    groupName = name.substr(0, dot);
+    groupIndex = atoi(name.substr(dot+1).c_str());
+    return true;
+    }
+
+  // "^(.*)(\.|_|-)([0-9.]+)\.(.*)$" then "^(.*)([a-zA-Z])([0-9.]+)\.(.*)$":
+  // the last separator followed by [0-9.]+ and a '.', the number taking as
+  // many characters as possible.
+  for (int pass = 0; pass < 2; ++pass)
+    {
+    for (int i = n-3; i >= 0; --i)
+      {
+      if (pass == 0? !vtkPVFileInformationIsSeparator(name[i]) :
+        !vtkPVFileInformationIsAlpha(name[i]))
+        {
+        continue;
+        }
+      int end = numEnd[i+1];
+      int dot = (end-1 >= i+2)? prevDot[end-1] : -1;
+      if (dot >= i+2)
+        {
+        groupName = name.substr(0, i+1) + ".." + name.substr(dot+1);
+        groupIndex = atoi(name.substr(i+1, dot-i-1).c_str());
+        return true;
+        }
+      }
+    }
+
+  // "^([0-9.]+)(\.|_|-)(.*)\.(.*)$" then "^([0-9.]+)([a-zA-Z])(.*)\.(.*)$":
+  // a leading [0-9.]+ followed by a separator before the last '.'.
+  int lastDot = prevDot[n-1];
+  int numberEnd = numEnd[0];
+  for (int pass = 0; pass < 2; ++pass)
+    {
+    for (int k = numberEnd; k >= 1; --k)
+      {
+      bool separator = (pass == 0)?
+        (k < numberEnd? name[k] == '.' :
+         (k < n && (name[k] == '_' || name[k] == '-'))) :
+        (k == numberEnd && k < n && vtkPVFileInformationIsAlpha(name[k]));
+      if (separator && lastDot > k)
+        {
+        groupName = ".." + name.substr(k, lastDot-k) + "." +
+          name.substr(lastDot+1);
+        groupIndex = atoi(name.substr(0, k).c_str());
+        return true;
+        }
+      }
+    }
+
+  // "^(.*[^0-9])([0-9]+)([^0-9]+)$": the digits before the trailing
+  // non-digits, preceded by a non-digit.
+  int tail = n;
+  while (tail > 0 && !(name[tail-1] >= '0' && name[tail-1] <= '9'))
+    {
+    --tail;
+    }
+  if (tail < n && tail > 0)
+    {
+    int digits = tail;
+    while (digits > 0 && name[digits-1] >= '0' && name[digits-1] <= '9')
+      {
+      --digits;
+      }
+    if (digits > 0)
+      {
+      groupName = name.substr(0, digits) + ".." + name.substr(tail);
+      groupIndex = atoi(name.substr(digits, tail-digits).c_str());
+      return true;
+      }
+    }
+  return false;
+}
+
 //-----------------------------------------------------------------------------
 void vtkPVFileInformation::OrganizeCollection(vtkPVFileInformationSet& info_set)
 {
@@ -976,25 +1276,6 @@ void vtkPVFileInformation::OrganizeCollection(vtkPVFileInformationSet& info_set)
   vtkstd::string prefix = this->FullPath;
   vtkPVFileInformationAddTerminatingSlash(prefix);
 
-  // sequence ending with numbers.
-  vtksys::RegularExpression reg_ex("^(.*)\\.([0-9.]+)$");
-  // sequence ending with extension.
-  vtksys::RegularExpression reg_ex2("^(.*)(\\.|_|-)([0-9.]+)\\.(.*)$");
-  
-  // sequence ending with extension, but with no ". or _" before
-  // the series number.
-  vtksys::RegularExpression reg_ex3("^(.*)([a-zA-Z])([0-9.]+)\\.(.*)$");
-  // sequence ending with extension, and starting with series number
-  // followed by ". or _".
-  vtksys::RegularExpression reg_ex4("^([0-9.]+)(\\.|_|-)(.*)\\.(.*)$");
-  // sequence ending with extension, and starting with series number,
-  // but not followed by ". or _".
-  vtksys::RegularExpression reg_ex5("^([0-9.]+)([a-zA-Z])(.*)\\.(.*)$");
-
-  // fallback: any sequence with a number in the middle (taking the last number
-  // if multiple exist).
-  vtksys::RegularExpression reg_ex_last("^(.*[^0-9])([0-9]+)([^0-9]+)$");
-
   for (vtkPVFileInformationSet::iterator iter = info_set.begin();
     iter != info_set.end(); )
     {
@@ -1002,45 +1283,10 @@ void vtkPVFileInformation::OrganizeCollection(vtkPVFileInformationSet& info_set)
 
     if (obj->Type != FILE_GROUP && !IsDirectory(obj->Type))
       {
-      bool match = false;
       vtkstd::string groupName;
       int groupIndex = -1;
-      if (reg_ex.find(obj->GetName()))
-        {
-        groupName = reg_ex.match(1);
-        groupIndex = atoi(reg_ex.match(2).c_str());
-        match = true;
-        }
-      else if (reg_ex2.find(obj->GetName()))
-        {
-        groupName = reg_ex2.match(1) + reg_ex2.match(2) + ".." + reg_ex2.match(4);
-        groupIndex = atoi(reg_ex2.match(3).c_str());
-        match = true;
-        }
-      else if (reg_ex3.find(obj->GetName()))
-        {
-        groupName = reg_ex3.match(1) + reg_ex3.match(2) + ".." + reg_ex3.match(4);
-        groupIndex = atoi(reg_ex3.match(3).c_str());
-        match = true;
-        }
-      else if (reg_ex4.find(obj->GetName()))
-        {
-        groupName = ".." + reg_ex4.match(2) + reg_ex4.match(3) + "." + reg_ex4.match(4);
-        groupIndex = atoi(reg_ex4.match(1).c_str());
-        match = true;
-        }
-      else if (reg_ex5.find(obj->GetName()))
-        {
-        groupName = ".." + reg_ex5.match(2) + reg_ex5.match(3) + "." + reg_ex5.match(4);
-        groupIndex = atoi(reg_ex5.match(1).c_str());
-        match = true;
-        }
-      else if (reg_ex_last.find(obj->GetName()))
-        {
-        groupName = reg_ex_last.match(1) + ".." + reg_ex_last.match(3);
-        groupIndex = atoi(reg_ex_last.match(2).c_str());
-        match = true;
-        }
+      bool match = vtkPVFileInformationGetSeriesName(
+        obj->GetName(), groupName, groupIndex);
 
       if (match)
         {
@@ -22,15 +22,19 @@
 #include "vtkObjectFactory.h"
 #include "vtkProcessModule.h"
 #include "vtkRemoteConnection.h"
+#include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
 #include "vtkTimerLog.h"
 #include "vtkToolkits.h" // For VTK_USE_MPI
+#include "vtkWeakPointer.h"
 
 #ifdef VTK_USE_MPI
+#include "vtkMPI.h"
 #include "vtkMPICommunicator.h"
 #include "vtkMPIController.h"
 #endif
 
+#include <vtkstd/algorithm>
 #include <vtkstd/vector>
 #include <vtkstd/deque>
 #include <vtkstd/string>
@@ -45,6 +49,10 @@
 
 #define MIN_PROGRESS_INTERVAL_IN_SECS 0.3
 
+// Progress events can be very frequent. Abort requests are looked for at
+// most this often.
+#define MIN_ABORT_CHECK_INTERVAL_IN_SECS 0.1
+
 inline const char* vtkGetProgressText(vtkObjectBase* o)
 {
   vtkAlgorithm* alg = vtkAlgorithm::SafeDownCast(o);
@@ -216,12 +224,32 @@ public:
   bool EnableProgress;
   bool ForceAsyncRequestReceived;
 
+  // Abort state of the current execution. AbortForwarded is set once the
+  // request has been sent to the server (on the client) or to the
+  // satellites (on the root). ExecutionCount counts the PrepareProgress()
+  // calls and tags the requests sent to satellites so that late requests
+  // do not abort the next execution.
+  bool AbortRequested;
+  bool AbortForwarded;
+  int ExecutionCount;
+  double LastAbortCheck;
+  typedef vtkstd::vector<vtkWeakPointer<vtkAlgorithm> > VectorOfAlgorithms;
+  VectorOfAlgorithms AbortedAlgorithms;
+
+  // Ids of the objects aborted on any process, collected by
+  // CleanupPendingProgress().
+  vtkstd::vector<int> AbortedObjectIDs;
+
   vtkTimerLog* ProgressTimer;
   vtkInternals()
     {
     this->AsyncRequestValid = false;
     this->EnableProgress = false;
     this->ForceAsyncRequestReceived = false;
+    this->AbortRequested = false;
+    this->AbortForwarded = false;
+    this->ExecutionCount = 0;
+    this->LastAbortCheck = 0.0;
     this->ProgressTimer = vtkTimerLog::New();
     this->ProgressTimer->StartTimer();
     }
@@ -308,6 +336,34 @@ void vtkPVProgressHandler::DetermineProcessType()
 void vtkPVProgressHandler::PrepareProgress()
 {
   this->Internals->EnableProgress = true;
+  this->Internals->AbortRequested = false;
+  this->Internals->AbortForwarded = false;
+  this->Internals->LastAbortCheck = 0.0;
+  this->Internals->AbortedObjectIDs.clear();
+  this->Internals->ExecutionCount++;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::AbortExecution()
+{
+  if (!this->Internals->EnableProgress || this->Internals->AbortRequested)
+    {
+    return;
+    }
+
+  this->Internals->AbortRequested = true;
+  if (this->ProcessType == CLIENTSERVER_CLIENT)
+    {
+    // The server root looks for this message, without receiving it, while
+    // its algorithms report progress. It is received and discarded by the
+    // server connection once the current request has been processed.
+    vtkRemoteConnection* rconn =
+      vtkRemoteConnection::SafeDownCast(this->Connection);
+    int temp = 1;
+    rconn->GetSocketController()->Send(&temp, 1, 1,
+      vtkProcessModule::ABORT_EXECUTION_TAG);
+    this->Internals->AbortForwarded = true;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -324,7 +380,10 @@ void vtkPVProgressHandler::CleanupPendingProgress()
   // been put in the message queue by other processes.
 
   // Receive progress from all children and then send the "Cleaned" signal
-  // to the parent (if any).
+  // to the parent (if any). The ids of the aborted objects travel with the
+  // "Cleaned" signal so that the client learns about every abort.
+  this->Internals->AbortedObjectIDs.clear();
+  this->CollectAbortedAlgorithms();
 
   if (this->ProcessType == ALL_IN_ONE)
     {
@@ -334,6 +393,7 @@ void vtkPVProgressHandler::CleanupPendingProgress()
 
   if (this->ProcessType == SATELLITE)
     {
+    this->ReceiveAbortFromRoot();
     this->CleanupSatellites();
     }
 
@@ -342,11 +402,17 @@ void vtkPVProgressHandler::CleanupPendingProgress()
     // Receive progress from satellites, if any.
     this->CleanupSatellites(); 
 
-    // Send reply to client.
+    // Send reply to client: the number of aborted objects, followed by
+    // their ids.
     vtkRemoteConnection* rconn =
       vtkRemoteConnection::SafeDownCast(this->Connection);
-    int temp=0;
-    rconn->GetSocketController()->Send(&temp, 1, 1, CLEANUP_TAG);
+    int count = static_cast<int>(this->Internals->AbortedObjectIDs.size());
+    rconn->GetSocketController()->Send(&count, 1, 1, CLEANUP_TAG);
+    if (count > 0)
+      {
+      rconn->GetSocketController()->Send(
+        &this->Internals->AbortedObjectIDs[0], count, 1, ABORTED_OBJECTS_TAG);
+      }
     }
 
   if (this->ProcessType == CLIENTSERVER_CLIENT)
@@ -355,14 +421,71 @@ void vtkPVProgressHandler::CleanupPendingProgress()
     // consume any progress messages sent by the server.
     vtkRemoteConnection* rconn =
       vtkRemoteConnection::SafeDownCast(this->Connection);
-    int temp=0;
-    rconn->GetSocketController()->Receive(&temp, 1, 1, CLEANUP_TAG);
+    int count=0;
+    rconn->GetSocketController()->Receive(&count, 1, 1, CLEANUP_TAG);
+    if (count > 0)
+      {
+      vtkstd::vector<int> ids(count);
+      rconn->GetSocketController()->Receive(&ids[0], count, 1,
+        ABORTED_OBJECTS_TAG);
+      this->AddAbortedObjects(&ids[0], count);
+      }
     }
 
   this->Internals->ProgressStore.Clear();
   this->Internals->EnableProgress = false;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::CollectAbortedAlgorithms()
+{
+  // Aborted algorithms have marked their partial outputs as generated. Make
+  // sure they execute again on the next update.
+  vtkInternals::VectorOfAlgorithms::iterator iter;
+  for (iter = this->Internals->AbortedAlgorithms.begin();
+    iter != this->Internals->AbortedAlgorithms.end(); ++iter)
+    {
+    vtkAlgorithm* alg = iter->GetPointer();
+    if (alg)
+      {
+      alg->Modified();
+      int id = this->Internals->GetIDFromObject(alg);
+      this->AddAbortedObjects(&id, 1);
+      }
+    }
+  this->Internals->AbortedAlgorithms.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::AddAbortedObjects(const int* ids, int count)
+{
+  vtkstd::vector<int>& aborted = this->Internals->AbortedObjectIDs;
+  for (int cc=0; cc < count; cc++)
+    {
+    if (ids[cc] != 0 &&
+      vtkstd::find(aborted.begin(), aborted.end(), ids[cc]) == aborted.end())
+      {
+      aborted.push_back(ids[cc]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVProgressHandler::GetNumberOfAbortedObjects()
+{
+  return static_cast<int>(this->Internals->AbortedObjectIDs.size());
+}
+
+//----------------------------------------------------------------------------
+int vtkPVProgressHandler::GetAbortedObjectID(int index)
+{
+  if (index < 0 || index >= this->GetNumberOfAbortedObjects())
+    {
+    return 0;
+    }
+  return this->Internals->AbortedObjectIDs[index];
+}
+
 //----------------------------------------------------------------------------
 void vtkPVProgressHandler::CleanupSatellites()
 {
@@ -375,21 +498,37 @@ void vtkPVProgressHandler::CleanupSatellites()
     int numProcs = controller->GetNumberOfProcesses();
 
     // As we wait on these receives, we will consume any progress messages sent
-    // by the satellites
+    // by the satellites. Each satellite sends its id and the number of
+    // objects it aborted, followed by their ids.
     if (myId == 0)
       {
       for (int cc=1; cc < numProcs; cc++)
         {
-        int temp = 0;
-        controller->Receive(&temp, 1,
+        int header[2] = {0, 0};
+        controller->Receive(header, 2,
           vtkMultiProcessController::ANY_SOURCE,
           vtkPVProgressHandler::CLEANUP_TAG);
+        if (header[1] > 0)
+          {
+          vtkstd::vector<int> ids(header[1]);
+          controller->Receive(&ids[0], header[1], header[0],
+            vtkPVProgressHandler::ABORTED_OBJECTS_TAG);
+          this->AddAbortedObjects(&ids[0], header[1]);
+          }
         }
       }
     else
       {
       // Send the CLEANUP_TAG to the root node.
-      controller->Send(&myId, 1, 0, vtkPVProgressHandler::CLEANUP_TAG);
+      int header[2];
+      header[0] = myId;
+      header[1] = static_cast<int>(this->Internals->AbortedObjectIDs.size());
+      controller->Send(header, 2, 0, vtkPVProgressHandler::CLEANUP_TAG);
+      if (header[1] > 0)
+        {
+        controller->Send(&this->Internals->AbortedObjectIDs[0], header[1], 0,
+          vtkPVProgressHandler::ABORTED_OBJECTS_TAG);
+        }
       }
     if (this->Internals->AsyncRequestValid)
       {
@@ -413,6 +552,17 @@ void vtkPVProgressHandler::OnProgressEvent(vtkObject* obj,
     {
     return;
     }
+
+  if (this->CheckForAbort())
+    {
+    vtkAlgorithm* alg = vtkAlgorithm::SafeDownCast(obj);
+    if (alg && !alg->GetAbortExecute())
+      {
+      alg->SetAbortExecute(1);
+      this->Internals->AbortedAlgorithms.push_back(alg);
+      }
+    }
+
   vtkstd::string text = ::vtkGetProgressText(obj);
   if (text.size() > 128)
     {
@@ -424,6 +574,95 @@ void vtkPVProgressHandler::OnProgressEvent(vtkObject* obj,
   this->RefreshProgress();
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVProgressHandler::CheckForAbort()
+{
+  vtkInternals* internals = this->Internals;
+  if (!internals->AbortRequested)
+    {
+    double now = vtkTimerLog::GetUniversalTime();
+    if (now - internals->LastAbortCheck < MIN_ABORT_CHECK_INTERVAL_IN_SECS)
+      {
+      return false;
+      }
+    internals->LastAbortCheck = now;
+
+    if (this->ProcessType == CLIENTSERVER_SERVER_ROOT)
+      {
+      vtkRemoteConnection* rconn =
+        vtkRemoteConnection::SafeDownCast(this->Connection);
+      vtkSocketCommunicator* comm = vtkSocketCommunicator::SafeDownCast(
+        rconn->GetSocketController()->GetCommunicator());
+      if (comm &&
+        comm->HasPendingMessage(vtkProcessModule::ABORT_EXECUTION_TAG))
+        {
+        internals->AbortRequested = true;
+        }
+      }
+    else if (this->ProcessType == SATELLITE)
+      {
+      this->ReceiveAbortFromRoot();
+      }
+    }
+
+#ifdef VTK_USE_MPI
+  if (internals->AbortRequested && !internals->AbortForwarded &&
+    (this->ProcessType == ALL_IN_ONE ||
+     this->ProcessType == CLIENTSERVER_SERVER_ROOT))
+    {
+    internals->AbortForwarded = true;
+    vtkMPIController* controller = vtkMPIController::SafeDownCast(
+      vtkMultiProcessController::GetGlobalController());
+    if (controller && controller->GetLocalProcessId() == 0)
+      {
+      int numProcs = controller->GetNumberOfProcesses();
+      for (int cc=1; cc < numProcs; cc++)
+        {
+        controller->Send(&internals->ExecutionCount, 1, cc,
+          vtkPVProgressHandler::ABORT_EXECUTION_TAG);
+        }
+      }
+    }
+#endif
+
+  return internals->AbortRequested;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::ReceiveAbortFromRoot()
+{
+#ifdef VTK_USE_MPI
+  vtkMPIController* controller = vtkMPIController::SafeDownCast(
+    vtkMultiProcessController::GetGlobalController());
+  vtkMPICommunicator* comm = controller?
+    vtkMPICommunicator::SafeDownCast(controller->GetCommunicator()) : 0;
+  if (!comm)
+    {
+    return;
+    }
+
+  // Requests sent for an earlier execution are consumed and ignored.
+  int pending = 1;
+  while (pending)
+    {
+    MPI_Status status;
+    pending = 0;
+    MPI_Iprobe(0, vtkPVProgressHandler::ABORT_EXECUTION_TAG,
+      *comm->GetMPIComm()->GetHandle(), &pending, &status);
+    if (pending)
+      {
+      int executionCount = -1;
+      controller->Receive(&executionCount, 1, 0,
+        vtkPVProgressHandler::ABORT_EXECUTION_TAG);
+      if (executionCount == this->Internals->ExecutionCount)
+        {
+        this->Internals->AbortRequested = true;
+        }
+      }
+    }
+#endif
+}
+
 //----------------------------------------------------------------------------
 void vtkPVProgressHandler::RefreshProgress()
 {
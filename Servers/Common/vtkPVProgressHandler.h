@@ -65,6 +65,25 @@ public:
   // from the server.
   void HandleServerProgress(int progress, const char* text);
 
+  // Description:
+  // Requests the execution in progress to be aborted. On the client of a
+  // client-server connection, the request is sent to the server root which
+  // forwards it to the satellites. Every algorithm reporting progress after
+  // the request is aborted (vtkAlgorithm::AbortExecute is set), and
+  // aborted algorithms are marked modified in CleanupPendingProgress() so
+  // that their partial outputs are not reused. Their ids are sent back
+  // with the reply to CleanupPendingProgress(). Ignored outside a
+  // PrepareProgress()/CleanupPendingProgress() pair.
+  void AbortExecution();
+
+  // Description:
+  // Returns the ids, as given to RegisterProgressEvent(), of the objects
+  // aborted on any process during the last execution. On the client of a
+  // client-server connection these are the objects aborted on the server.
+  // Valid from CleanupPendingProgress() to the next PrepareProgress().
+  int GetNumberOfAbortedObjects();
+  int GetAbortedObjectID(int index);
+
 //BTX
   // Description:
   // These methods are used by vtkPVMPICommunicator to handle the progress
@@ -87,7 +106,9 @@ protected:
   enum eTAGS
     {
     CLEANUP_TAG = 188969,
-    PROGRESS_EVENT_TAG = 188970
+    PROGRESS_EVENT_TAG = 188970,
+    ABORT_EXECUTION_TAG = 188971,
+    ABORTED_OBJECTS_TAG = 188972
     };
 
   // Description:
@@ -114,6 +135,25 @@ protected:
 
   void SetLocalProgress(int progress, const char* text);
 
+  // Description:
+  // Checks whether an abort was requested by the client (on the server
+  // root) or by the root (on satellites), and forwards it to the
+  // satellites. Returns true if the execution is to be aborted.
+  bool CheckForAbort();
+
+  // Description:
+  // Consumes the abort requests the root sent to this satellite.
+  void ReceiveAbortFromRoot();
+
+  // Description:
+  // Adds the ids of the algorithms aborted on this process to the list of
+  // aborted objects, and marks the algorithms modified.
+  void CollectAbortedAlgorithms();
+
+  // Description:
+  // Adds ids to the list of aborted objects, skipping duplicates.
+  void AddAbortedObjects(const int* ids, int count);
+
   void SendProgressToClient();
   void SendProgressToRoot();
   int ReceiveProgressFromSatellites();
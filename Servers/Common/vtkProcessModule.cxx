@@ -78,6 +78,13 @@ public:
   // was sent. This is used to determine where to send the
   // CleanupPendingProgress request.
   vtkTypeUInt32 ProgressServersFlag;
+
+  // Connection the first SendPrepareProgress request was sent on. This is
+  // the connection AbortExecution() aborts the execution on.
+  vtkIdType ProgressConnectionID;
+
+  // Ids of the objects aborted during the last execution.
+  vtkstd::vector<vtkClientServerID> AbortedObjectIDs;
 };
 
 //*****************************************************************************
@@ -1187,6 +1194,7 @@ void vtkProcessModule::SendPrepareProgress(vtkIdType connectionId,
   if (this->ProgressRequests == 0)
     {
     this->Internals->ProgressServersFlag = servers;
+    this->Internals->ProgressConnectionID = connectionId;
     this->GUIHelper->SendPrepareProgress();
     this->InvokeEvent(vtkCommand::StartEvent);
     }
@@ -1240,6 +1248,23 @@ void vtkProcessModule::SendCleanupPendingProgress(vtkIdType connectionId)
   
   this->GUIHelper->SendCleanupPendingProgress();
 
+  // The progress handler of the connection has collected the objects
+  // aborted on all processes.
+  this->Internals->AbortedObjectIDs.clear();
+  vtkProcessModuleConnection* conn = this->ConnectionManager->
+    GetConnectionFromID(this->Internals->ProgressConnectionID);
+  if (conn)
+    {
+    vtkPVProgressHandler* handler = conn->GetProgressHandler();
+    int numAborted = handler->GetNumberOfAbortedObjects();
+    for (int cc=0; cc < numAborted; cc++)
+      {
+      vtkClientServerID id;
+      id.ID = static_cast<vtkTypeUInt32>(handler->GetAbortedObjectID(cc));
+      this->Internals->AbortedObjectIDs.push_back(id);
+      }
+    }
+
   if (this->LastProgress < 100 && this->LastProgressName)
     {
     this->LastProgress = 100;
@@ -1248,6 +1273,42 @@ void vtkProcessModule::SendCleanupPendingProgress(vtkIdType connectionId)
     this->SetLastProgressName(0);
     }
   this->InvokeEvent(vtkCommand::EndEvent);
+
+  if (!this->Internals->AbortedObjectIDs.empty())
+    {
+    this->InvokeEvent(vtkProcessModule::ExecutionAbortedEvent);
+    }
+}
+
+//-----------------------------------------------------------------------------
+int vtkProcessModule::GetNumberOfAbortedObjects()
+{
+  return static_cast<int>(this->Internals->AbortedObjectIDs.size());
+}
+
+//-----------------------------------------------------------------------------
+vtkClientServerID vtkProcessModule::GetAbortedObjectID(int index)
+{
+  if (index < 0 || index >= this->GetNumberOfAbortedObjects())
+    {
+    return vtkClientServerID();
+    }
+  return this->Internals->AbortedObjectIDs[index];
+}
+
+//-----------------------------------------------------------------------------
+void vtkProcessModule::AbortExecution()
+{
+  if (this->ProgressRequests <= 0)
+    {
+    return;
+    }
+  vtkProcessModuleConnection* conn = this->ConnectionManager->
+    GetConnectionFromID(this->Internals->ProgressConnectionID);
+  if (conn)
+    {
+    conn->GetProgressHandler()->AbortExecution();
+    }
 }
 
 //-----------------------------------------------------------------------------
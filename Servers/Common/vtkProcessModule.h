@@ -26,6 +26,7 @@
 
 #include "vtkObject.h"
 #include "vtkClientServerID.h" // needed for UniqueID.
+#include "vtkCommand.h" // needed for ExecutionAbortedEvent.
 
 class vtkCacheSizeKeeper;
 class vtkCallbackCommand;
@@ -85,6 +86,11 @@ public:
     EXCEPTION_UNKNOWN   = 31418
     };
 
+  enum AbortExecutionEnum
+    {
+    ABORT_EXECUTION_TAG = 31419
+    };
+
   static inline int GetRootId(int serverId)
     {
     if (serverId & CLIENT)
@@ -305,6 +311,35 @@ public:
   vtkPVProgressHandler* GetActiveProgressHandler();
   //ETX
 
+  // Description:
+  // Requests the pipeline execution in progress on the connection that
+  // the pending progress request was sent to to be aborted. This is meant
+  // to be called from a ProgressEvent observer while the client waits on
+  // the server. The executing algorithms, on all server processes, are
+  // aborted the next time they report progress and are marked modified
+  // so that they execute again on the next update. The ids of the aborted
+  // objects are reported back to the client, which fires
+  // ExecutionAbortedEvent. Does nothing when no progress request is
+  // pending.
+  void AbortExecution();
+
+  // Description:
+  // Event fired at the end of SendCleanupPendingProgress() when objects
+  // were aborted during the execution it ends. The ids of their VTK
+  // objects, on any process, are given by GetAbortedObjectID(). Observers
+  // are expected to mark the proxies of those objects dirty, as their
+  // outputs are partial.
+  enum ProcessModuleEvents
+    {
+    ExecutionAbortedEvent = vtkCommand::UserEvent + 1
+    };
+
+  // Description:
+  // Returns the ids of the VTK objects aborted during the last execution
+  // that was ended by SendCleanupPendingProgress().
+  int GetNumberOfAbortedObjects();
+  vtkClientServerID GetAbortedObjectID(int index);
+
   // Description:
   // Internal methods. Do not call directly.
   void PrepareProgress();
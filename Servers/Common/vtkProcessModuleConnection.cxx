@@ -133,6 +133,13 @@ void vtkProcessModuleConnection::OnWrongTagEvent(
   const char* ptr = data;
   memcpy(&tag, ptr, sizeof(tag));
 
+  if (tag == vtkProcessModule::ABORT_EXECUTION_TAG)
+    {
+    // Abort request that arrived after the execution it was meant for was
+    // over (see vtkPVProgressHandler::AbortExecution()). Nothing to do.
+    return;
+    }
+
   if ( tag != vtkProcessModule::PROGRESS_EVENT_TAG 
     && tag != vtkProcessModule::EXCEPTION_EVENT_TAG)
     {
@@ -14,6 +14,8 @@
 =========================================================================*/
 #include "vtkRemoteConnection.h"
 
+#include "vtkByteSwap.h"
+#include "vtkClientServerStream.h"
 #include "vtkClientSocket.h"
 #include "vtkCommand.h"
 #include "vtkObjectFactory.h"
@@ -21,9 +23,23 @@
 #include "vtkProcessModuleConnectionManager.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
+#include "vtkSmartPointer.h"
+#include "vtkZLibDataCompressor.h"
 
+#include <string.h>
 #include <vtkstd/vector>
 
+// The information sent to the client starts with a header of four 32 bit
+// little endian words: the magic number, the version of the format, the
+// flags and the length of the stream once uncompressed.
+#define VTK_REMOTE_CONNECTION_INFORMATION_MAGIC 0x46495650 // "PVIF"
+#define VTK_REMOTE_CONNECTION_INFORMATION_VERSION 1
+#define VTK_REMOTE_CONNECTION_INFORMATION_HEADER_SIZE 16
+#define VTK_REMOTE_CONNECTION_INFORMATION_COMPRESSED 0x1
+
+// Streams smaller than this are sent uncompressed.
+#define VTK_REMOTE_CONNECTION_INFORMATION_COMPRESSION_THRESHOLD 4096
+
 class vtkRemoteConnection::vtkInternal : public
                                          vtkstd::vector<vtkRemoteConnection*>
 {
@@ -100,6 +116,96 @@ void vtkRemoteConnection::Deactivate()
   this->Internal->pop_back();
 }
 
+//-----------------------------------------------------------------------------
+void vtkRemoteConnection::EncodeInformation(vtkClientServerStream& css,
+  vtkstd::vector<unsigned char>& buffer)
+{
+  const unsigned char* data;
+  size_t length;
+  css.GetData(&data, &length);
+
+  const size_t headerSize = VTK_REMOTE_CONNECTION_INFORMATION_HEADER_SIZE;
+  vtkTypeUInt32 header[4];
+  header[0] = VTK_REMOTE_CONNECTION_INFORMATION_MAGIC;
+  header[1] = VTK_REMOTE_CONNECTION_INFORMATION_VERSION;
+  header[2] = 0;
+  header[3] = static_cast<vtkTypeUInt32>(length);
+
+  size_t payloadSize = 0;
+  if (length >= VTK_REMOTE_CONNECTION_INFORMATION_COMPRESSION_THRESHOLD)
+    {
+    // The information is compressed on the server root while the client
+    // waits for it, so favor speed over ratio.
+    vtkSmartPointer<vtkZLibDataCompressor> compressor =
+      vtkSmartPointer<vtkZLibDataCompressor>::New();
+    compressor->SetCompressionLevel(1);
+    buffer.resize(headerSize +
+      compressor->GetMaximumCompressionSpace(length));
+    payloadSize = compressor->Compress(data, length,
+      &buffer[headerSize], buffer.size() - headerSize);
+    if (payloadSize > 0 && payloadSize < length)
+      {
+      header[2] |= VTK_REMOTE_CONNECTION_INFORMATION_COMPRESSED;
+      }
+    }
+  if (!(header[2] & VTK_REMOTE_CONNECTION_INFORMATION_COMPRESSED))
+    {
+    payloadSize = length;
+    buffer.resize(headerSize + payloadSize);
+    if (length > 0)
+      {
+      memcpy(&buffer[headerSize], data, length);
+      }
+    }
+  buffer.resize(headerSize + payloadSize);
+  vtkByteSwap::Swap4LERange(header, 4);
+  memcpy(&buffer[0], header, headerSize);
+}
+
+//-----------------------------------------------------------------------------
+int vtkRemoteConnection::DecodeInformation(const unsigned char* data,
+  size_t length, vtkClientServerStream& css)
+{
+  const size_t headerSize = VTK_REMOTE_CONNECTION_INFORMATION_HEADER_SIZE;
+  vtkTypeUInt32 header[4];
+  if (length >= headerSize)
+    {
+    memcpy(header, data, headerSize);
+    vtkByteSwap::Swap4LERange(header, 4);
+    }
+  if (length < headerSize ||
+    header[0] != VTK_REMOTE_CONNECTION_INFORMATION_MAGIC)
+    {
+    // Not encoded, i.e. sent by an older server.
+    return css.SetData(data, length);
+    }
+  if (header[1] > VTK_REMOTE_CONNECTION_INFORMATION_VERSION)
+    {
+    vtkGenericWarningMacro("Information encoded with unsupported version "
+      << header[1] << ".");
+    return 0;
+    }
+
+  data += headerSize;
+  length -= headerSize;
+  if (!(header[2] & VTK_REMOTE_CONNECTION_INFORMATION_COMPRESSED))
+    {
+    return css.SetData(data, length);
+    }
+
+  vtkstd::vector<unsigned char> uncompressed(header[3]);
+  vtkSmartPointer<vtkZLibDataCompressor> compressor =
+    vtkSmartPointer<vtkZLibDataCompressor>::New();
+  if (uncompressed.empty() ||
+    compressor->Uncompress(data, length, &uncompressed[0],
+      uncompressed.size()) != uncompressed.size())
+    {
+    vtkGenericWarningMacro("Failed to uncompress the information.");
+    return 0;
+    }
+  return css.SetData(&uncompressed[0], uncompressed.size());
+}
+
 //-----------------------------------------------------------------------------
 void vtkRemoteConnection::PrintSelf(ostream& os, vtkIndent indent)
 {
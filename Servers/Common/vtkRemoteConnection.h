@@ -23,7 +23,11 @@
 #define __vtkRemoteConnection_h
 
 #include "vtkProcessModuleConnection.h"
+//BTX
+#include <vtkstd/vector> // needed for vtkstd::vector
+//ETX
 
+class vtkClientServerStream;
 class vtkClientSocket;
 class vtkSocketController;
 
@@ -79,6 +83,22 @@ protected:
   vtkRemoteConnection();
   ~vtkRemoteConnection(); 
 
+  // Description:
+  // Encodes the serialized information \c css sent by the server root in
+  // reply to a gather information request. The stream is prefixed by a
+  // versioned header, and compressed when large: the information of
+  // composite datasets with many blocks is mostly repeated array names and
+  // types. \c buffer is resized to the encoded length.
+  static void EncodeInformation(vtkClientServerStream& css,
+    vtkstd::vector<unsigned char>& buffer);
+
+  // Description:
+  // Decodes information encoded with EncodeInformation() into \c css.
+  // Data without the header is taken as a plain stream.
+  // Returns 1 on success, 0 on failure.
+  static int DecodeInformation(const unsigned char* data, size_t length,
+    vtkClientServerStream& css);
+
 private:
   vtkRemoteConnection(const vtkRemoteConnection&); // Not implemented.
   void operator=(const vtkRemoteConnection&); // Not implemented.
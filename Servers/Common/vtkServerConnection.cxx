@@ -353,9 +353,14 @@ void vtkServerConnection::GatherInformationFromController(vtkSocketController* c
     delete [] data2;
     return;
     }
-  stream.SetData(data2, length2);
-  info->CopyFromStream(&stream);
+  if (!vtkRemoteConnection::DecodeInformation(data2, length2, stream))
+    {
+    vtkErrorMacro("Failed to decode information.");
+    delete [] data2;
+    return;
+    }
   delete [] data2;
+  info->CopyFromStream(&stream);
 }
 
 //-----------------------------------------------------------------------------
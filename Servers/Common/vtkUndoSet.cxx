@@ -160,6 +160,12 @@ void vtkUndoSet::LoadState(vtkPVXMLElement* elem)
   vtkWarningMacro("State loading is not supported.");
 }
 
+//-----------------------------------------------------------------------------
+unsigned long vtkUndoSet::GetActualMemorySize()
+{
+  return 0;
+}
+
 //-----------------------------------------------------------------------------
 void vtkUndoSet::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -87,6 +87,13 @@ public:
   // (such as vtkSMUndoRedoStateLoader).
   virtual void LoadState(vtkPVXMLElement* element);
 
+  // Description:
+  // Returns the memory, in kibibytes, used to keep this set. vtkUndoStack
+  // uses it to enforce its MemoryLimit. The elements of the set do not
+  // report their size, hence this returns 0. Subclasses keeping the state
+  // of the set themselves should override it.
+  virtual unsigned long GetActualMemorySize();
+
 protected:
   vtkUndoSet();
   ~vtkUndoSet();
@@ -28,6 +28,7 @@ vtkUndoStack::vtkUndoStack()
   this->InUndo = false;
   this->InRedo = false;
   this->StackDepth = 10;
+  this->MemoryLimit = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -56,9 +57,37 @@ void vtkUndoStack::Push(const char* label, vtkUndoSet* changeSet)
     }
   this->Internal->UndoStack.push_back(
     vtkUndoStackInternal::Element(label, changeSet));
+
+  if (this->MemoryLimit > 0)
+    {
+    unsigned long size = this->GetActualMemorySize();
+    while (size > this->MemoryLimit && this->Internal->UndoStack.size() > 1)
+      {
+      size -= this->Internal->UndoStack.front().UndoSet->GetActualMemorySize();
+      this->Internal->UndoStack.erase(this->Internal->UndoStack.begin());
+      }
+    }
   this->Modified();
 }
 
+//-----------------------------------------------------------------------------
+unsigned long vtkUndoStack::GetActualMemorySize()
+{
+  unsigned long size = 0;
+  vtkUndoStackInternal::VectorOfElements::iterator iter;
+  for (iter = this->Internal->UndoStack.begin();
+    iter != this->Internal->UndoStack.end(); ++iter)
+    {
+    size += iter->UndoSet->GetActualMemorySize();
+    }
+  for (iter = this->Internal->RedoStack.begin();
+    iter != this->Internal->RedoStack.end(); ++iter)
+    {
+    size += iter->UndoSet->GetActualMemorySize();
+    }
+  return size;
+}
+
 //-----------------------------------------------------------------------------
 unsigned int vtkUndoStack::GetNumberOfUndoSets()
 {
@@ -184,4 +213,5 @@ void vtkUndoStack::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "InUndo: " << this->InUndo << endl;
   os << indent << "InRedo: " << this->InRedo << endl;
   os << indent << "StackDepth: " << this->StackDepth << endl;
+  os << indent << "MemoryLimit: " << this->MemoryLimit << endl;
 }
@@ -146,12 +146,26 @@ public:
   // Default is 10.
   vtkSetClampMacro(StackDepth, int, 1, 100);
   vtkGetMacro(StackDepth, int);
+
+  // Description:
+  // Get/Set the maximum memory, in kibibytes, used by the sets on the undo
+  // stack as reported by vtkUndoSet::GetActualMemorySize(). When a set is
+  // pushed and the limit is exceeded, the oldest sets are removed, though
+  // the set just pushed is always kept. 0 means no limit. Default is 0.
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+
+  // Description:
+  // Returns the memory, in kibibytes, used by the sets on the undo and redo
+  // stacks.
+  unsigned long GetActualMemorySize();
 protected:
   vtkUndoStack();
   ~vtkUndoStack();
 
   vtkUndoStackInternal* Internal;
   int StackDepth;
+  unsigned long MemoryLimit;
 
 private:
   vtkUndoStack(const vtkUndoStack&); // Not implemented.
@@ -62,6 +62,7 @@
 #include "vtkPVJoystickFlyIn.h"
 #include "vtkPVJoystickFlyOut.h"
 #include "vtkPVLinearExtrusionFilter.h"
+#include "vtkPVLocatorSelector.h"
 #include "vtkPVLODActor.h"
 #include "vtkPVLODVolume.h"
 #include "vtkPVMain.h"
@@ -173,6 +174,7 @@ int main(int , char *[])
   c = vtkPVJoystickFlyIn::New(); c->Print(cout); c->Delete();
   c = vtkPVJoystickFlyOut::New(); c->Print(cout); c->Delete();
   c = vtkPVLinearExtrusionFilter::New(); c->Print(cout); c->Delete();
+  c = vtkPVLocatorSelector::New(); c->Print(cout); c->Delete();
   c = vtkPVLODActor::New(); c->Print(cout); c->Delete();
   c = vtkPVLODVolume::New(); c->Print(cout); c->Delete();
   c = vtkPVMain::New(); c->Print(cout); c->Delete();
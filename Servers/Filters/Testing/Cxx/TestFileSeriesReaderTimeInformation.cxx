@@ -0,0 +1,273 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the DistributeTimeInformation mode of vtkFileSeriesReader. Run it on
+// more than one process: the files between the first and the last one must
+// each be queried by a single process, and every process must end up with
+// the same time information as when all the files are queried everywhere.
+
+#include "vtkExecutive.h"
+#include "vtkFileSeriesReader.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMPIController.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vtkstd/vector>
+#include <vtksys/ios/sstream>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NUMBER_OF_FILES 7
+
+//-----------------------------------------------------------------------------
+// Reports time information computed from the index in its file name
+// ("file<index>"), and records the files it was asked about. File i has
+// the time steps 10*i, ..., 10*i+i, except for file 3, which only has a
+// time range.
+class vtkTestTimeReader : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTestTimeReader* New();
+  vtkTypeRevisionMacro(vtkTestTimeReader, vtkPolyDataAlgorithm);
+
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+
+  vtkstd::vector<int> QueriedFiles;
+
+protected:
+  vtkTestTimeReader()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->FileName = 0;
+    }
+  ~vtkTestTimeReader()
+    {
+    this->SetFileName(0);
+    }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+    {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    int index = atoi(this->FileName + 4);
+    this->QueriedFiles.push_back(index);
+
+    outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_RANGE());
+    if (index == 3)
+      {
+      double timeRange[2] = { 30.0, 35.0 };
+      outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(),
+                   timeRange, 2);
+      return 1;
+      }
+
+    vtkstd::vector<double> timeSteps;
+    for (int i = 0; i <= index; i++)
+      {
+      timeSteps.push_back(10.0*index + i);
+      }
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(),
+                 &timeSteps[0], static_cast<int>(timeSteps.size()));
+    return 1;
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector*)
+    {
+    return 1;
+    }
+
+  char* FileName;
+
+private:
+  vtkTestTimeReader(const vtkTestTimeReader&); // Not implemented.
+  void operator=(const vtkTestTimeReader&); // Not implemented.
+};
+
+vtkStandardNewMacro(vtkTestTimeReader);
+vtkCxxRevisionMacro(vtkTestTimeReader, "$Revision$");
+
+//-----------------------------------------------------------------------------
+// Sets the file name directly on the test reader instead of going through
+// the process module's interpreter.
+class vtkTestFileSeriesReader : public vtkFileSeriesReader
+{
+public:
+  static vtkTestFileSeriesReader* New();
+  vtkTypeRevisionMacro(vtkTestFileSeriesReader, vtkFileSeriesReader);
+
+protected:
+  vtkTestFileSeriesReader() {}
+  ~vtkTestFileSeriesReader() {}
+
+  virtual void SetReaderFileName(const char* fname)
+    {
+    vtkTestTimeReader* reader = vtkTestTimeReader::SafeDownCast(this->Reader);
+    if (reader && fname)
+      {
+      reader->SetFileName(fname);
+      }
+    this->SetCurrentFileName(fname);
+    }
+
+private:
+  vtkTestFileSeriesReader(const vtkTestFileSeriesReader&); // Not implemented.
+  void operator=(const vtkTestFileSeriesReader&); // Not implemented.
+};
+
+vtkStandardNewMacro(vtkTestFileSeriesReader);
+vtkCxxRevisionMacro(vtkTestFileSeriesReader, "$Revision$");
+
+//-----------------------------------------------------------------------------
+static vtkTestFileSeriesReader* NewSeriesReader(vtkTestTimeReader* reader,
+                                                int distribute)
+{
+  vtkTestFileSeriesReader* series = vtkTestFileSeriesReader::New();
+  series->SetReader(reader);
+  series->SetDistributeTimeInformation(distribute);
+  for (int i = 0; i < NUMBER_OF_FILES; i++)
+    {
+    vtksys_ios::ostringstream name;
+    name << "file" << i;
+    series->AddFileName(name.str().c_str());
+    }
+  series->UpdateInformation();
+  return series;
+}
+
+//-----------------------------------------------------------------------------
+static bool CompareTimeInformation(vtkInformation* info,
+                                   vtkInformation* expected)
+{
+  int length = info->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  if (length < 1 || length !=
+      expected->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+    {
+    return false;
+    }
+  double* steps = info->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  double* expectedSteps =
+    expected->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  for (int i = 0; i < length; i++)
+    {
+    if (steps[i] != expectedSteps[i])
+      {
+      return false;
+      }
+    }
+  double* range = info->Get(vtkStreamingDemandDrivenPipeline::TIME_RANGE());
+  double* expectedRange =
+    expected->Get(vtkStreamingDemandDrivenPipeline::TIME_RANGE());
+  return (range && expectedRange &&
+          range[0] == expectedRange[0] && range[1] == expectedRange[1]);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+  int success = 1;
+
+  // Reference: every process queries all the files.
+  vtkSmartPointer<vtkTestTimeReader> serialReader =
+    vtkSmartPointer<vtkTestTimeReader>::New();
+  vtkFileSeriesReader* serial = NewSeriesReader(serialReader, 0);
+  if (static_cast<int>(serialReader->QueriedFiles.size()) != NUMBER_OF_FILES)
+    {
+    cerr << "Process " << myId << ": expected all the files to be queried "
+         << "when not distributing the time information." << endl;
+    success = 0;
+    }
+
+  vtkSmartPointer<vtkTestTimeReader> reader =
+    vtkSmartPointer<vtkTestTimeReader>::New();
+  vtkFileSeriesReader* distributed = NewSeriesReader(reader, 1);
+
+  // The first and the last files are queried everywhere, the other ones by
+  // a single process.
+  int numQueried[NUMBER_OF_FILES];
+  memset(numQueried, 0, sizeof(numQueried));
+  vtkstd::vector<int>::iterator iter;
+  for (iter = reader->QueriedFiles.begin();
+       iter != reader->QueriedFiles.end(); ++iter)
+    {
+    numQueried[*iter]++;
+    }
+  for (int i = 0; i < NUMBER_OF_FILES; i++)
+    {
+    bool mine = (i == 0 || i == NUMBER_OF_FILES-1 || i % numProcs == myId);
+    if (numQueried[i] != (mine ? 1 : 0))
+      {
+      cerr << "Process " << myId << ": file " << i << " was queried "
+           << numQueried[i] << " times." << endl;
+      success = 0;
+      }
+    }
+  int totalQueried[NUMBER_OF_FILES];
+  controller->AllReduce(numQueried, totalQueried, NUMBER_OF_FILES,
+                        vtkCommunicator::SUM_OP);
+  for (int i = 1; i < NUMBER_OF_FILES-1; i++)
+    {
+    if (totalQueried[i] != 1)
+      {
+      cerr << "File " << i << " was queried by " << totalQueried[i]
+           << " processes." << endl;
+      success = 0;
+      }
+    }
+
+  // Every process gets the time information of all the files.
+  vtkInformation* outInfo =
+    distributed->GetExecutive()->GetOutputInformation(0);
+  if (!CompareTimeInformation(outInfo,
+                              serial->GetExecutive()->GetOutputInformation(0)))
+    {
+    cerr << "Process " << myId << ": the distributed time information "
+         << "differs from the serial one." << endl;
+    success = 0;
+    }
+  int numSteps =
+    outInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  if (numSteps != NUMBER_OF_FILES*(NUMBER_OF_FILES+1)/2 - 4)
+    {
+    cerr << "Process " << myId << ": expected "
+         << NUMBER_OF_FILES*(NUMBER_OF_FILES+1)/2 - 4 << " time steps, got "
+         << numSteps << endl;
+    success = 0;
+    }
+
+  serial->Delete();
+  distributed->Delete();
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::MIN_OP);
+
+  controller->Finalize();
+  vtkMultiProcessController::SetGlobalController(0);
+  controller->Delete();
+
+  return allSuccess ? 0 : 1;
+}
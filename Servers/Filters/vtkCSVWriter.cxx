@@ -28,9 +28,12 @@
 #include "vtkTable.h"
 #include "vtkSmartPointer.h"
 
+#include <vtkstd/string>
 #include <vtkstd/vector>
 #include <vtksys/ios/sstream>
 
+#include <stdio.h>
+
 vtkStandardNewMacro(vtkCSVWriter);
 vtkCxxRevisionMacro(vtkCSVWriter, "$Revision$");
 //-----------------------------------------------------------------------------
@@ -84,36 +87,84 @@ bool vtkCSVWriter::OpenFile()
     return false;
     }
 
+  delete this->Stream;
   this->Stream = fptr;
   return true;
 }
 
+//-----------------------------------------------------------------------------
+// The values are formatted into a buffer which is written to the file in
+// large blocks, rather than through the stream one value at a time. The
+// formatting matches what operator<< produces with the default precision.
+static const size_t vtkCSVWriterBlockSize = 1 << 20;
+
+template <class T>
+inline void vtkCSVWriterFormatValue(vtkstd::string& buffer, T value)
+{
+  char digits[32];
+  int pos = 32;
+  bool negative = value < 0;
+  do
+    {
+    int digit = static_cast<int>(value % 10);
+    digits[--pos] = static_cast<char>('0' + (digit < 0 ? -digit : digit));
+    value /= 10;
+    }
+  while (value != 0);
+  if (negative)
+    {
+    digits[--pos] = '-';
+    }
+  buffer.append(digits + pos, 32 - pos);
+}
+
+inline void vtkCSVWriterFormatValue(vtkstd::string& buffer, double value)
+{
+  char digits[64];
+  int length = sprintf(digits, "%g", value);
+  buffer.append(digits, length);
+}
+
+inline void vtkCSVWriterFormatValue(vtkstd::string& buffer, float value)
+{
+  vtkCSVWriterFormatValue(buffer, static_cast<double>(value));
+}
+
+// Characters are written as they are, like operator<< does.
+inline void vtkCSVWriterFormatValue(vtkstd::string& buffer, char value)
+{
+  buffer += value;
+}
+
+inline void vtkCSVWriterFormatValue(vtkstd::string& buffer, signed char value)
+{
+  buffer += static_cast<char>(value);
+}
+
+inline void vtkCSVWriterFormatValue(vtkstd::string& buffer,
+                                    unsigned char value)
+{
+  buffer += static_cast<char>(value);
+}
+
 //-----------------------------------------------------------------------------
 template <class iterT>
 void vtkCSVWriterGetDataString(
-  iterT* iter, vtkIdType tupleIndex, ofstream* stream, vtkCSVWriter* writer,
-  bool* first)
+  iterT* iter, vtkIdType tupleIndex, vtkstd::string& buffer,
+  vtkCSVWriter* writer, bool* first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex* numComps;
   for (int cc=0; cc < numComps; cc++)
     {
-    if ((index+cc) < iter->GetNumberOfValues())
+    if (*first == false)
       {
-      if (*first == false)
-        {
-        (*stream) << writer->GetFieldDelimiter();
-        }
-      *first = false;
-      (*stream) << iter->GetValue(index+cc);
+      buffer += writer->GetFieldDelimiter();
       }
-    else
+    *first = false;
+    if ((index+cc) < iter->GetNumberOfValues())
       {
-      if (*first == false)
-        {
-        (*stream) << writer->GetFieldDelimiter();
-        }
-      *first = false;
+      vtkCSVWriterFormatValue(buffer, iter->GetValue(index+cc));
       }
     }
 }
@@ -122,28 +173,20 @@ void vtkCSVWriterGetDataString(
 VTK_TEMPLATE_SPECIALIZE
 void vtkCSVWriterGetDataString(
   vtkArrayIteratorTemplate<vtkStdString>* iter, vtkIdType tupleIndex, 
-  ofstream* stream, vtkCSVWriter* writer, bool* first)
+  vtkstd::string& buffer, vtkCSVWriter* writer, bool* first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex* numComps;
   for (int cc=0; cc < numComps; cc++)
     {
-    if ((index+cc) < iter->GetNumberOfValues())
+    if (*first == false)
       {
-      if (*first == false)
-        {
-        (*stream) << writer->GetFieldDelimiter();
-        }
-      *first = false;
-      (*stream) << writer->GetString(iter->GetValue(index+cc));
+      buffer += writer->GetFieldDelimiter();
       }
-    else
+    *first = false;
+    if ((index+cc) < iter->GetNumberOfValues())
       {
-      if (*first == false)
-        {
-        (*stream) << writer->GetFieldDelimiter();
-        }
-      *first = false;
+      buffer += writer->GetString(iter->GetValue(index+cc));
       }
     }
 }
@@ -215,6 +258,8 @@ void vtkCSVWriter::WriteTable(vtkTable* table)
     }
   (*this->Stream) << "\n";
 
+  vtkstd::string buffer;
+  buffer.reserve(vtkCSVWriterBlockSize + 4096);
   for (vtkIdType index=0; index < numRows; index++)
     {
     first = true;
@@ -225,12 +270,23 @@ void vtkCSVWriter::WriteTable(vtkTable* table)
         {
         vtkArrayIteratorTemplateMacro(
           vtkCSVWriterGetDataString(static_cast<VTK_TT*>(iter->GetPointer()),
-            index, this->Stream, this, &first));
+            index, buffer, this, &first));
         }
       }
-    (*this->Stream) << "\n";
+    buffer += "\n";
+    if (buffer.size() >= vtkCSVWriterBlockSize)
+      {
+      this->Stream->write(buffer.data(), buffer.size());
+      buffer.clear();
+      }
     }
+  this->Stream->write(buffer.data(), buffer.size());
 
+  if (this->Stream->fail())
+    {
+    vtkErrorMacro(<< "Error writing file: " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+    }
   this->Stream->close();
 }
 
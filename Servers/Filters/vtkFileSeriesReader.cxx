@@ -31,6 +31,7 @@
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkProcessModule.h"
 #include "vtkStdString.h"
@@ -349,6 +350,7 @@ vtkFileSeriesReader::vtkFileSeriesReader()
   this->CurrentFileName = 0;
 
   this->IgnoreReaderTime = 0;
+  this->DistributeTimeInformation = 0;
 
   this->LastRequestInformationIndex = -1;
 }
@@ -558,11 +560,21 @@ int vtkFileSeriesReader::RequestInformation(
     // Record the reported file time info.
     this->Internal->TimeRanges->AddTimeRange(0, outInfo);
 
-    // Query all the other files for time info.
-    for (int i = 1; i < numFiles; i++)
+    vtkMultiProcessController* controller =
+      vtkMultiProcessController::GetGlobalController();
+    if (this->DistributeTimeInformation && controller &&
+        controller->GetNumberOfProcesses() > 1 && numFiles > 2)
       {
-      this->RequestInformationForInput(i, request, outputVector);
-      this->Internal->TimeRanges->AddTimeRange(i, outInfo);
+      this->GatherTimeInformation(request, outputVector);
+      }
+    else
+      {
+      // Query all the other files for time info.
+      for (int i = 1; i < numFiles; i++)
+        {
+        this->RequestInformationForInput(i, request, outputVector);
+        this->Internal->TimeRanges->AddTimeRange(i, outInfo);
+        }
       }
     }
 
@@ -572,6 +584,104 @@ int vtkFileSeriesReader::RequestInformation(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkFileSeriesReader::GatherTimeInformation(
+                                             vtkInformation *request,
+                                             vtkInformationVector *outputVector)
+{
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkMultiProcessController* controller =
+    vtkMultiProcessController::GetGlobalController();
+  int numProcs = controller->GetNumberOfProcesses();
+  int myId = controller->GetLocalProcessId();
+  int numFiles = (int)this->GetNumberOfFileNames();
+
+  // Query the files in between the first and the last one assigned to this
+  // process. The time information of each is packed as: file index, number
+  // of time steps (-1 if the file has no time information), time range and
+  // time steps.
+  vtkstd::vector<double> localInfo;
+  for (int i = 1; i < numFiles-1; i++)
+    {
+    if (i % numProcs != myId)
+      {
+      continue;
+      }
+    this->RequestInformationForInput(i, request, outputVector);
+    double* timeSteps = 0;
+    int numTimeSteps = -1;
+    double timeRange[2] = { 0.0, 0.0 };
+    if (outInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+      {
+      timeSteps = outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+      numTimeSteps =
+        outInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+      timeRange[0] = timeSteps[0];
+      timeRange[1] = timeSteps[numTimeSteps-1];
+      }
+    if (outInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_RANGE()))
+      {
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange);
+      if (numTimeSteps < 0)
+        {
+        numTimeSteps = 0;
+        }
+      }
+    localInfo.push_back(i);
+    localInfo.push_back(numTimeSteps);
+    localInfo.push_back(timeRange[0]);
+    localInfo.push_back(timeRange[1]);
+    for (int j = 0; j < numTimeSteps; j++)
+      {
+      localInfo.push_back(timeSteps[j]);
+      }
+    }
+
+  // Gather the information of all the files on all processes.
+  int localLength = static_cast<int>(localInfo.size());
+  vtkstd::vector<int> lengths(numProcs);
+  controller->AllGather(&localLength, &lengths[0], 1);
+  vtkstd::vector<vtkIdType> recvLengths(numProcs);
+  vtkstd::vector<vtkIdType> offsets(numProcs);
+  vtkIdType totalLength = 0;
+  for (int p = 0; p < numProcs; p++)
+    {
+    recvLengths[p] = lengths[p];
+    offsets[p] = totalLength;
+    totalLength += lengths[p];
+    }
+  // Make sure that the buffers are not empty.
+  localInfo.push_back(0.0);
+  vtkstd::vector<double> allInfo(totalLength+1);
+  controller->AllGatherV(&localInfo[0], &allInfo[0], localLength,
+                         &recvLengths[0], &offsets[0]);
+
+  vtkIdType pos = 0;
+  while (pos < totalLength)
+    {
+    VTK_CREATE(vtkInformation, info);
+    int index = static_cast<int>(allInfo[pos]);
+    int numTimeSteps = static_cast<int>(allInfo[pos+1]);
+    if (numTimeSteps >= 0)
+      {
+      info->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(),
+                &allInfo[pos+2], 2);
+      }
+    if (numTimeSteps > 0)
+      {
+      info->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(),
+                &allInfo[pos+4], numTimeSteps);
+      }
+    this->Internal->TimeRanges->AddTimeRange(index, info);
+    pos += 4 + (numTimeSteps > 0 ? numTimeSteps : 0);
+    }
+
+  // Every process queries the last file so that the reader is left with the
+  // same information as when querying all the files.
+  this->RequestInformationForInput(numFiles-1, request, outputVector);
+  this->Internal->TimeRanges->AddTimeRange(numFiles-1, outInfo);
+}
+
 //----------------------------------------------------------------------------
 int vtkFileSeriesReader::RequestUpdateExtent(
                                  vtkInformation* vtkNotUsed(request),
@@ -781,4 +891,6 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "MetaFileName: " << this->MetaFileName << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "DistributeTimeInformation: "
+     << this->DistributeTimeInformation << endl;
 }
@@ -43,6 +43,15 @@
 // method is useful when the actual reader points to a set of files itself.  The
 // UseMetaFile toggles between these two methods of specifying files.
 //
+// When DistributeTimeInformation is on and there is more than one process,
+// the time information of the files is collected by splitting the files
+// among the processes and exchanging the results, so that every file is
+// opened by a single process instead of by all of them. This requires
+// RequestInformation to be called on all the processes of the global
+// controller at the same time, otherwise the processes deadlock. It is off
+// by default; the server manager turns it on only for the readers whose xml
+// sets distribute_time_information="1", such as the VTK XML readers.
+//
 
 #ifndef __vtkFileSeriesReader_h
 #define __vtkFileSeriesReader_h
@@ -131,6 +140,14 @@ public:
   vtkSetMacro(IgnoreReaderTime, int);
   vtkBooleanMacro(IgnoreReaderTime, int);
 
+  // Description:
+  // If true, the processes of the global controller split the files among
+  // themselves to collect their time information in RequestInformation.
+  // False by default.
+  vtkGetMacro(DistributeTimeInformation, int);
+  vtkSetMacro(DistributeTimeInformation, int);
+  vtkBooleanMacro(DistributeTimeInformation, int);
+
 protected:
   vtkFileSeriesReader();
   ~vtkFileSeriesReader();
@@ -155,6 +172,14 @@ protected:
                                      vtkInformation *request = NULL,
                                      vtkInformationVector *outputVector = NULL);
 
+  // Description:
+  // Collects the time information of the files other than the first one
+  // when DistributeTimeInformation is on: each process runs
+  // RequestInformation on its share of the files and the results are
+  // gathered on all processes.
+  virtual void GatherTimeInformation(vtkInformation *request,
+                                     vtkInformationVector *outputVector);
+
   // Description:
   // The last file index for which RequestInformationForInput was run.
   int LastRequestInformationIndex;
@@ -182,6 +207,7 @@ protected:
   virtual void UpdateMetaData();
 
   int IgnoreReaderTime;
+  int DistributeTimeInformation;
 
 private:
   vtkFileSeriesReader(const vtkFileSeriesReader&); // Not implemented.
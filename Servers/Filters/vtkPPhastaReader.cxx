@@ -19,6 +19,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
 #include "vtkMultiPieceDataSet.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
@@ -52,11 +53,20 @@ struct vtkPPhastaReaderInternal
   typedef vtkstd::map<int, vtkSmartPointer<vtkUnstructuredGrid> > 
   CachedGridsMapType;
   CachedGridsMapType CachedGrids;
+
+  // File name patterns of the meta-file, used by ReadPiece().
+  vtkstd::string GeometryPattern;
+  int GeometryHasPiece;
+  int GeometryHasTime;
+  vtkstd::string FieldPattern;
+  int FieldHasPiece;
+  int FieldHasTime;
 };
 
 //----------------------------------------------------------------------------
 vtkCxxRevisionMacro(vtkPPhastaReader, "$Revision$");
 vtkStandardNewMacro(vtkPPhastaReader);
+vtkCxxSetObjectMacro(vtkPPhastaReader, Controller, vtkMultiProcessController);
 
 //----------------------------------------------------------------------------
 vtkPPhastaReader::vtkPPhastaReader()
@@ -76,6 +86,10 @@ vtkPPhastaReader::vtkPPhastaReader()
 
   this->TimeStepRange[0] = 0;
   this->TimeStepRange[1] = 0;
+
+  this->NumberOfReaders = 0;
+  this->Controller = 0;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
 //----------------------------------------------------------------------------
@@ -90,6 +104,8 @@ vtkPPhastaReader::~vtkPPhastaReader()
     }
 
   delete this->Internal;
+
+  this->SetController(0);
 }
 
 //----------------------------------------------------------------------------
@@ -162,9 +178,9 @@ int vtkPPhastaReader::RequestData(vtkInformation*,
   MultiPieceDataSet->Delete();
 
   const char* geometryPattern = 0;
-  int geomHasPiece, geomHasTime;
+  int geomHasPiece = 0, geomHasTime = 0;
   const char* fieldPattern = 0;
-  int fieldHasPiece, fieldHasTime;
+  int fieldHasPiece = 0, fieldHasTime = 0;
 
   unsigned int numElements = rootElement->GetNumberOfNestedElements();
   for (unsigned int i=0; i<numElements; i++)
@@ -210,119 +226,223 @@ int vtkPPhastaReader::RequestData(vtkInformation*,
     return 0;
     }
 
-  char* geom_name = new char [ strlen(geometryPattern) + 60 ];
-  char* field_name = new char [ strlen(fieldPattern) + 60 ];
+  this->Internal->GeometryPattern = geometryPattern;
+  this->Internal->GeometryHasPiece = geomHasPiece;
+  this->Internal->GeometryHasTime = geomHasTime;
+  this->Internal->FieldPattern = fieldPattern;
+  this->Internal->FieldHasPiece = fieldHasPiece;
+  this->Internal->FieldHasTime = fieldHasTime;
 
-  // now loop over all of the files that I should load
-  for(int loadingPiece=piece;loadingPiece<numPieces;loadingPiece+=numProcPieces)
+  int numProcs = 1;
+  int myId = 0;
+  if (this->Controller)
     {
-    if (geomHasTime && geomHasPiece)
-      {
-      sprintf(geom_name, 
-              geometryPattern, 
-              this->Internal->TimeStepInfoMap[this->ActualTimeStep].GeomIndex, 
-              loadingPiece+1);
-      }
-    else if (geomHasPiece)
-      {
-      sprintf(geom_name, geometryPattern, loadingPiece+1);
-      }
-    else if (geomHasTime)
-      {
-      sprintf(geom_name, 
-              geometryPattern, 
-              this->Internal->TimeStepInfoMap[this->ActualTimeStep].GeomIndex);
-      }
-    else
-      {
-      strcpy(geom_name, geometryPattern);
-      }
-    
-    if (fieldHasTime && fieldHasPiece)
-      {
-      sprintf(field_name, 
-              fieldPattern, 
-              this->Internal->TimeStepInfoMap[this->ActualTimeStep].FieldIndex,
-              loadingPiece+1);
-      }
-    else if (fieldHasPiece)
-      {
-      sprintf(field_name, fieldPattern, loadingPiece+1);
-      }
-    else if (fieldHasTime)
-      {
-      sprintf(field_name, 
-              fieldPattern, 
-              this->Internal->TimeStepInfoMap[this->ActualTimeStep].FieldIndex);
-      }
-    else
+    numProcs = this->Controller->GetNumberOfProcesses();
+    myId = this->Controller->GetLocalProcessId();
+    }
+  int numReaders = this->NumberOfReaders < numProcs ?
+    this->NumberOfReaders : numProcs;
+
+  if (numReaders > 0 && numReaders < numProcs &&
+      numProcPieces == numProcs && piece == myId)
+    {
+    this->ReadAndScatterPieces(numPieces, numReaders, MultiPieceDataSet);
+    }
+  else
+    {
+    // now loop over all of the files that I should load
+    for(int loadingPiece=piece;
+        loadingPiece<numPieces;
+        loadingPiece+=numProcPieces)
       {
-      strcpy(geom_name, fieldPattern);
+      vtkSmartPointer<vtkUnstructuredGrid> copy = 
+        vtkSmartPointer<vtkUnstructuredGrid>::New();
+      this->ReadPiece(loadingPiece, copy);
+      MultiPieceDataSet->SetPiece(MultiPieceDataSet->GetNumberOfPieces(),
+                                  copy);
       }
-    
-    vtksys_ios::ostringstream geomFName;
-    vtkstd::string gpath = vtksys::SystemTools::GetFilenamePath(geom_name);
-    if (gpath.empty() || !vtksys::SystemTools::FileIsFullPath(gpath.c_str()))
+    }
+  
+  if (steps)
+    {
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEPS(),
+                                  steps+this->ActualTimeStep, 1);
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPPhastaReader::ReadAndScatterPieces(int numPieces,
+                                            int numReaders,
+                                            vtkMultiPieceDataSet* output)
+{
+  int numProcs = this->Controller->GetNumberOfProcesses();
+  int myId = this->Controller->GetLocalProcessId();
+
+  // Group i has the processes [i*numProcs/numReaders,
+  // (i+1)*numProcs/numReaders). The first process of a group reads the
+  // parts of all the processes of the group.
+  int group = 0;
+  while (myId >= (group + 1) * numProcs / numReaders)
+    {
+    group++;
+    }
+  int reader = group * numProcs / numReaders;
+  int endProcess = (group + 1) * numProcs / numReaders;
+
+  if (myId != reader)
+    {
+    for(int loadingPiece=myId;
+        loadingPiece<numPieces;
+        loadingPiece+=numProcs)
       {
-      vtkstd::string path = vtksys::SystemTools::GetFilenamePath(this->FileName);
-      if (!path.empty())
+      vtkSmartPointer<vtkUnstructuredGrid> copy = 
+        vtkSmartPointer<vtkUnstructuredGrid>::New();
+      if (!this->Controller->Receive(copy, reader,
+                                     vtkPPhastaReader::PIECE_TAG))
         {
-        geomFName << path.c_str() << "/";
+        vtkErrorMacro("Failed to receive piece " << loadingPiece
+                      << " from process " << reader);
         }
+      output->SetPiece(output->GetNumberOfPieces(), copy);
       }
-    geomFName << geom_name << ends;
-    this->Reader->SetGeometryFileName(geomFName.str().c_str());
+    return;
+    }
 
-    vtksys_ios::ostringstream fieldFName;
-    vtkstd::string fpath = vtksys::SystemTools::GetFilenamePath(field_name);
-    if (fpath.empty() || !vtksys::SystemTools::FileIsFullPath(fpath.c_str()))
+  // Read the parts in increasing order, which for each round of pieces
+  // are consecutive parts. A piece that cannot be read is sent empty so
+  // that the receiving process does not hang.
+  for(int base=0; base<numPieces; base+=numProcs)
+    {
+    for(int procId=reader; procId<endProcess; procId++)
       {
-      vtkstd::string path = vtksys::SystemTools::GetFilenamePath(this->FileName);
-      if (!path.empty())
+      int loadingPiece = base + procId;
+      if (loadingPiece >= numPieces)
+        {
+        break;
+        }
+      vtkSmartPointer<vtkUnstructuredGrid> copy = 
+        vtkSmartPointer<vtkUnstructuredGrid>::New();
+      this->ReadPiece(loadingPiece, copy);
+      if (procId == myId)
+        {
+        output->SetPiece(output->GetNumberOfPieces(), copy);
+        }
+      else
         {
-        fieldFName << path.c_str() << "/";
+        this->Controller->Send(copy, procId, vtkPPhastaReader::PIECE_TAG);
         }
       }
-    fieldFName << field_name << ends;
-    this->Reader->SetFieldFileName(fieldFName.str().c_str());
+    }
+}
 
-    vtkPPhastaReaderInternal::CachedGridsMapType::iterator CachedCopy = 
-      this->Internal->CachedGrids.find(loadingPiece);
+//----------------------------------------------------------------------------
+void vtkPPhastaReader::ReadPiece(int loadingPiece, vtkUnstructuredGrid* output)
+{
+  vtkPPhastaReaderInternal::TimeStepInfo& timeStepInfo =
+    this->Internal->TimeStepInfoMap[this->ActualTimeStep];
+  const char* geometryPattern = this->Internal->GeometryPattern.c_str();
+  const char* fieldPattern = this->Internal->FieldPattern.c_str();
 
-    // if there is a cached copy, use that
-    if(CachedCopy != this->Internal->CachedGrids.end())
+  char* geom_name = new char [ strlen(geometryPattern) + 60 ];
+  char* field_name = new char [ strlen(fieldPattern) + 60 ];
+
+  if (this->Internal->GeometryHasTime && this->Internal->GeometryHasPiece)
+    {
+    sprintf(geom_name, 
+            geometryPattern, 
+            timeStepInfo.GeomIndex, 
+            loadingPiece+1);
+    }
+  else if (this->Internal->GeometryHasPiece)
+    {
+    sprintf(geom_name, geometryPattern, loadingPiece+1);
+    }
+  else if (this->Internal->GeometryHasTime)
+    {
+    sprintf(geom_name, geometryPattern, timeStepInfo.GeomIndex);
+    }
+  else
+    {
+    strcpy(geom_name, geometryPattern);
+    }
+    
+  if (this->Internal->FieldHasTime && this->Internal->FieldHasPiece)
+    {
+    sprintf(field_name, 
+            fieldPattern, 
+            timeStepInfo.FieldIndex,
+            loadingPiece+1);
+    }
+  else if (this->Internal->FieldHasPiece)
+    {
+    sprintf(field_name, fieldPattern, loadingPiece+1);
+    }
+  else if (this->Internal->FieldHasTime)
+    {
+    sprintf(field_name, fieldPattern, timeStepInfo.FieldIndex);
+    }
+  else
+    {
+    strcpy(field_name, fieldPattern);
+    }
+    
+  vtksys_ios::ostringstream geomFName;
+  vtkstd::string gpath = vtksys::SystemTools::GetFilenamePath(geom_name);
+  if (gpath.empty() || !vtksys::SystemTools::FileIsFullPath(gpath.c_str()))
+    {
+    vtkstd::string path = vtksys::SystemTools::GetFilenamePath(this->FileName);
+    if (!path.empty())
       {
-      this->Reader->SetCachedGrid(CachedCopy->second);
+      geomFName << path.c_str() << "/";
       }
+    }
+  geomFName << geom_name << ends;
+  this->Reader->SetGeometryFileName(geomFName.str().c_str());
 
-    this->Reader->Update();
-    
-    if(CachedCopy == this->Internal->CachedGrids.end())
+  vtksys_ios::ostringstream fieldFName;
+  vtkstd::string fpath = vtksys::SystemTools::GetFilenamePath(field_name);
+  if (fpath.empty() || !vtksys::SystemTools::FileIsFullPath(fpath.c_str()))
+    {
+    vtkstd::string path = vtksys::SystemTools::GetFilenamePath(this->FileName);
+    if (!path.empty())
       {
-      vtkSmartPointer<vtkUnstructuredGrid> cached = 
-        vtkSmartPointer<vtkUnstructuredGrid>::New();
-      cached->ShallowCopy(this->Reader->GetOutput());
-      cached->GetPointData()->Initialize();
-      cached->GetCellData()->Initialize();
-      cached->GetFieldData()->Initialize();
-      this->Internal->CachedGrids[loadingPiece] = cached;
+      fieldFName << path.c_str() << "/";
       }
-    vtkSmartPointer<vtkUnstructuredGrid> copy = 
-      vtkSmartPointer<vtkUnstructuredGrid>::New();
-    copy->ShallowCopy(this->Reader->GetOutput());
-    MultiPieceDataSet->SetPiece(MultiPieceDataSet->GetNumberOfPieces(),copy);
     }
-  
+  fieldFName << field_name << ends;
+  this->Reader->SetFieldFileName(fieldFName.str().c_str());
+
   delete [] geom_name;
   delete [] field_name;
-  
-  if (steps)
+
+  vtkPPhastaReaderInternal::CachedGridsMapType::iterator CachedCopy = 
+    this->Internal->CachedGrids.find(loadingPiece);
+
+  // if there is a cached copy, use that
+  if(CachedCopy != this->Internal->CachedGrids.end())
     {
-    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEPS(),
-                                  steps+this->ActualTimeStep, 1);
+    this->Reader->SetCachedGrid(CachedCopy->second);
+    }
+  else
+    {
+    this->Reader->SetCachedGrid(0);
     }
 
-  return 1;
+  this->Reader->Update();
+    
+  if(CachedCopy == this->Internal->CachedGrids.end())
+    {
+    vtkSmartPointer<vtkUnstructuredGrid> cached = 
+      vtkSmartPointer<vtkUnstructuredGrid>::New();
+    cached->ShallowCopy(this->Reader->GetOutput());
+    cached->GetPointData()->Initialize();
+    cached->GetCellData()->Initialize();
+    cached->GetFieldData()->Initialize();
+    this->Internal->CachedGrids[loadingPiece] = cached;
+    }
+  output->ShallowCopy(this->Reader->GetOutput());
 }
 
 //----------------------------------------------------------------------------
@@ -619,5 +739,7 @@ void vtkPPhastaReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "TimeStepRange: " 
      << this->TimeStepRange[0] << " " << this->TimeStepRange[1]
      << endl;
+  os << indent << "NumberOfReaders: " << this->NumberOfReaders << endl;
+  os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -119,8 +119,11 @@
 
 #include "vtkMultiBlockDataSetAlgorithm.h"
 
+class vtkMultiPieceDataSet;
+class vtkMultiProcessController;
 class vtkPVXMLParser;
 class vtkPhastaReader;
+class vtkUnstructuredGrid;
 
 //BTX
 struct vtkPPhastaReaderInternal;
@@ -147,6 +150,23 @@ public:
   // The min and max values of timesteps.
   vtkGetVector2Macro(TimeStepRange, int);
 
+  // Description:
+  // Number of processes reading the Phasta files when running in parallel.
+  // The processes are split into that many groups of consecutive processes
+  // and the first process of each group reads the parts of all the
+  // processes of its group and sends them their pieces. This reduces the
+  // number of processes opening files when there are many more parts than
+  // processes. 0 (the default) means that every process reads its own
+  // parts.
+  vtkSetClampMacro(NumberOfReaders, int, 0, VTK_LARGE_INTEGER);
+  vtkGetMacro(NumberOfReaders, int);
+
+  // Description:
+  // Controller used to send the pieces read by a process to the other
+  // processes of its group. Set to the global controller by default.
+  virtual void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+
   static int CanReadFile(const char *filename);
 
 protected:
@@ -173,6 +193,28 @@ protected:
 
   int ActualTimeStep;
 
+  int NumberOfReaders;
+  vtkMultiProcessController* Controller;
+
+//BTX
+  // Description:
+  // Reads the part loadingPiece of the current time step into output.
+  void ReadPiece(int loadingPiece, vtkUnstructuredGrid* output);
+
+  // Description:
+  // Reads the parts of the group of this process if it is the first of the
+  // group and sends them to the other processes, or receives the parts of
+  // this process otherwise. The pieces of this process are added to output.
+  void ReadAndScatterPieces(int numPieces,
+                            int numReaders,
+                            vtkMultiPieceDataSet* output);
+
+  enum
+  {
+    PIECE_TAG = 14300
+  };
+//ETX
+
 private:
   vtkPPhastaReaderInternal* Internal;
   
@@ -21,14 +21,20 @@
 #include "vtkGarbageCollector.h"
 #include "vtkHierarchicalBoxDataSet.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkCellArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMaskPoints.h"
 #include "vtkMath.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUniformGrid.h"
 
 vtkCxxRevisionMacro(vtkPVGlyphFilter, "$Revision$");
@@ -46,6 +52,7 @@ vtkPVGlyphFilter::vtkPVGlyphFilter()
     vtkMultiProcessController::GetGlobalController()->GetNumberOfProcesses() : 1;
   this->UseMaskPoints = 1;
   this->InputIsUniformGrid = 0;
+  this->GenerateInstances = 0;
 
   this->BlockOnRatio = 0;
   this->BlockMaxNumPts = 0;
@@ -195,8 +202,7 @@ int vtkPVGlyphFilter::RequestData(
   if (!this->UseMaskPoints)
     {
     // yes.
-    int retVal
-      = this->Superclass::RequestData(request, inputVector, outputVector);
+    int retVal = this->GlyphExecute(request, inputVector, outputVector);
     this->BlockGlyphAllPoints= !this->UseMaskPoints;
     return retVal;
     }
@@ -267,9 +273,202 @@ int vtkPVGlyphFilter::MaskAndExecute(vtkIdType numPts, vtkIdType maxNumPts,
   vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
   inInfo->Set(vtkDataObject::DATA_OBJECT(), this->MaskPoints->GetOutput());
 
+  return this->GlyphExecute(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGlyphFilter::GlyphExecute(vtkInformation* request,
+                                   vtkInformationVector** inputVector,
+                                   vtkInformationVector* outputVector)
+{
+  if (this->GenerateInstances)
+    {
+    return this->InstancesExecute(inputVector, outputVector);
+    }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
+//----------------------------------------------------------------------------
+// Mirrors the scaling and orientation logic of vtkGlyph3D::RequestData(), but
+// stores the per-point transform parameters instead of applying them to a
+// copy of the glyph source.
+int vtkPVGlyphFilter::InstancesExecute(vtkInformationVector** inputVector,
+                                       vtkInformationVector* outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  vtkDataSet *input = vtkDataSet::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData *output = vtkPolyData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+  output->Initialize();
+
+  vtkIdType numPts = input->GetNumberOfPoints();
+  if (numPts < 1)
+    {
+    return 1;
+    }
+
+  vtkPointData* pd = input->GetPointData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkDataArray* inSScalars = this->GetInputArrayToProcess(0, inputVector);
+  vtkDataArray* inVectors = this->GetInputArrayToProcess(1, inputVector);
+  vtkDataArray* inNormals = this->GetInputArrayToProcess(2, inputVector);
+
+  unsigned char* inGhostLevels = 0;
+  vtkUnsignedCharArray* ghosts = vtkUnsignedCharArray::SafeDownCast(
+    pd->GetArray("vtkGhostLevels"));
+  if (ghosts && ghosts->GetNumberOfComponents() == 1)
+    {
+    inGhostLevels = ghosts->GetPointer(0);
+    }
+  int requestedGhostLevel = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+
+  double den = this->Range[1] - this->Range[0];
+  if (den == 0.0)
+    {
+    den = 1.0;
+    }
+  int haveVectors = (this->VectorMode != VTK_VECTOR_ROTATION_OFF &&
+    ((this->VectorMode == VTK_USE_VECTOR && inVectors != NULL) ||
+     (this->VectorMode == VTK_USE_NORMAL && inNormals != NULL)));
+
+  vtkPoints* newPts = vtkPoints::New();
+  newPts->Allocate(numPts);
+  vtkCellArray* newVerts = vtkCellArray::New();
+  newVerts->Allocate(newVerts->EstimateSize(numPts, 1));
+  outputPD->CopyAllocate(pd, numPts);
+
+  vtkFloatArray* newScales = vtkFloatArray::New();
+  newScales->SetNumberOfComponents(3);
+  newScales->Allocate(3*numPts);
+  newScales->SetName("GlyphInstanceScale");
+  vtkFloatArray* newOrientations = vtkFloatArray::New();
+  newOrientations->SetNumberOfComponents(3);
+  newOrientations->Allocate(3*numPts);
+  newOrientations->SetName("GlyphInstanceOrientation");
+  vtkIdTypeArray* pointIds = 0;
+  if (this->GeneratePointIds)
+    {
+    pointIds = vtkIdTypeArray::New();
+    pointIds->SetName(this->PointIdsName);
+    pointIds->Allocate(numPts);
+    }
+
+  double x[3], v[3] = {1.0, 0.0, 0.0};
+  double scale[3], vMag = 0.0;
+  for (vtkIdType inPtId = 0; inPtId < numPts; ++inPtId)
+    {
+    if (!(inPtId % 10000))
+      {
+      this->UpdateProgress(static_cast<double>(inPtId)/numPts);
+      if (this->GetAbortExecute())
+        {
+        break;
+        }
+      }
+
+    if (inGhostLevels && inGhostLevels[inPtId] > requestedGhostLevel)
+      {
+      continue;
+      }
+    if (!this->IsPointVisible(input, inPtId))
+      {
+      continue;
+      }
+
+    scale[0] = scale[1] = scale[2] = 1.0;
+    if (inSScalars && (this->ScaleMode == VTK_SCALE_BY_SCALAR ||
+                       this->ScaleMode == VTK_DATA_SCALING_OFF))
+      {
+      scale[0] = scale[1] = scale[2] = inSScalars->GetComponent(inPtId, 0);
+      }
+
+    double orientation[3] = {1.0, 0.0, 0.0};
+    if (haveVectors)
+      {
+      if (this->VectorMode == VTK_USE_NORMAL)
+        {
+        inNormals->GetTuple(inPtId, v);
+        }
+      else
+        {
+        inVectors->GetTuple(inPtId, v);
+        }
+      vMag = vtkMath::Norm(v);
+      if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        {
+        scale[0] = v[0];
+        scale[1] = v[1];
+        scale[2] = v[2];
+        }
+      else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+        {
+        scale[0] = scale[1] = scale[2] = vMag;
+        }
+      if (this->Orient && vMag > 0.0)
+        {
+        orientation[0] = v[0];
+        orientation[1] = v[1];
+        orientation[2] = v[2];
+        }
+      }
+
+    for (int i = 0; i < 3; ++i)
+      {
+      if (this->Clamping)
+        {
+        scale[i] = (scale[i] < this->Range[0] ? this->Range[0] :
+                    (scale[i] > this->Range[1] ? this->Range[1] : scale[i]));
+        scale[i] = (scale[i] - this->Range[0]) / den;
+        }
+      if (this->Scaling)
+        {
+        scale[i] = (this->ScaleMode == VTK_DATA_SCALING_OFF) ?
+          this->ScaleFactor : scale[i]*this->ScaleFactor;
+        }
+      else
+        {
+        scale[i] = 1.0;
+        }
+      if (scale[i] == 0.0)
+        {
+        scale[i] = 1.0e-10;
+        }
+      }
+
+    input->GetPoint(inPtId, x);
+    vtkIdType outPtId = newPts->InsertNextPoint(x);
+    newVerts->InsertNextCell(1, &outPtId);
+    outputPD->CopyData(pd, inPtId, outPtId);
+    newScales->InsertNextTuple(scale);
+    newOrientations->InsertNextTuple(orientation);
+    if (pointIds)
+      {
+      pointIds->InsertNextValue(inPtId);
+      }
+    }
+
+  output->SetPoints(newPts);
+  output->SetVerts(newVerts);
+  newPts->Delete();
+  newVerts->Delete();
+  outputPD->AddArray(newScales);
+  outputPD->AddArray(newOrientations);
+  newScales->Delete();
+  newOrientations->Delete();
+  if (pointIds)
+    {
+    outputPD->AddArray(pointIds);
+    pointIds->Delete();
+    }
+  output->Squeeze();
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // We are overloading this so that blanking will be supported
 // otehrwise we could use vtkMaskPoints filter.
@@ -446,8 +645,7 @@ int vtkPVGlyphFilter::RequestCompositeData(vtkInformation* request,
       // We have set all ofthe parameters that will be used in 
       // our overloaded IsPoitVisible. Now let the glypher take over.
       newInInfo->Set(vtkDataObject::DATA_OBJECT(), ds);
-      retVal =
-        this->Superclass::RequestData(request, inputVs, outputVector);
+      retVal = this->GlyphExecute(request, inputVs, outputVector);
       // Accumulate the results.
       tmpOut->ShallowCopy(output);
       append->AddInput(tmpOut);
@@ -503,4 +701,7 @@ void vtkPVGlyphFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UseMaskPoints: " << (this->UseMaskPoints?"on":"off") << endl;
 
   os << indent << "NumberOfProcesses: " << this->NumberOfProcesses << endl;
+
+  os << indent << "GenerateInstances: "
+     << (this->GenerateInstances?"on":"off") << endl;
 }
@@ -15,7 +15,10 @@
 // .NAME vtkPVGlyphFilter - Glyph filter
 //
 // .SECTION Description
-// This is a subclass of vtkGlyph3D that allows selection of input scalars
+// This is a subclass of vtkGlyph3D that allows selection of input scalars.
+// When GenerateInstances is on, the filter does not copy the glyph source at
+// every point. It produces one vertex per glyphed point instead, which can be
+// rendered with vtkScatterPlotMapper (see vtkSMGlyph3DRepresentationProxy).
 
 #ifndef __vtkPVGlyphFilter_h
 #define __vtkPVGlyphFilter_h
@@ -52,6 +55,17 @@ public:
   void SetRandomMode(int mode);
   int GetRandomMode();
 
+  // Description:
+  // When on, the output has one vertex per glyphed point, the input point
+  // data and two extra 3-component arrays: "GlyphInstanceScale" holding the
+  // scale factors vtkGlyph3D would apply along x, y and z (ScaleFactor
+  // included) and "GlyphInstanceOrientation" holding the direction the glyph
+  // x axis is rotated onto. IndexMode is ignored in this mode.
+  // Default is off.
+  vtkSetMacro(GenerateInstances, int);
+  vtkGetMacro(GenerateInstances, int);
+  vtkBooleanMacro(GenerateInstances, int);
+
   // Description:
   // In processing composite datasets, will check if a point
   // is visible as long as the dataset being process if a
@@ -76,6 +90,19 @@ protected:
   
   vtkIdType GatherTotalNumberOfPoints(vtkIdType localNumPts);
 
+  // Description:
+  // Glyphs the dataset set in the first input information object, either
+  // through vtkGlyph3D::RequestData() or InstancesExecute() depending on
+  // GenerateInstances.
+  int GlyphExecute(vtkInformation* request,
+                   vtkInformationVector** inputVector,
+                   vtkInformationVector* outputVector);
+
+  // Description:
+  // Produces the vertex-only output used when GenerateInstances is on.
+  int InstancesExecute(vtkInformationVector** inputVector,
+                       vtkInformationVector* outputVector);
+
   int MaskAndExecute(vtkIdType numPts, vtkIdType maxNumPts,
                      vtkDataSet* input,
                      vtkInformation* request,
@@ -87,6 +114,7 @@ protected:
   int NumberOfProcesses;
   int UseMaskPoints;
   int InputIsUniformGrid;
+  int GenerateInstances;
   
   vtkIdType BlockGlyphAllPoints;
   vtkIdType BlockMaxNumPts;
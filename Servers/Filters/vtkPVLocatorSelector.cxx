@@ -0,0 +1,407 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVLocatorSelector.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCell.h"
+#include "vtkCellLocator.h"
+#include "vtkDataSet.h"
+#include "vtkExtractSelectedFrustum.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkPlanes.h"
+#include "vtkPoints.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkSmartPointer.h"
+#include "vtkWeakPointer.h"
+
+#include <vtkstd/map>
+#include <vtkstd/vector>
+
+//----------------------------------------------------------------------------
+// vtkExtractSelectedFrustum already knows how to intersect a cell with a
+// frustum, this simply exposes it.
+class vtkPVLocatorSelectorFrustum : public vtkExtractSelectedFrustum
+{
+public:
+  static vtkPVLocatorSelectorFrustum* New();
+  vtkTypeRevisionMacro(vtkPVLocatorSelectorFrustum, vtkExtractSelectedFrustum);
+
+  // Description:
+  // Returns true if the cell is (partially) inside the frustum.
+  // OverallBoundsTest() must have been called after CreateFrustum().
+  bool CellIntersects(vtkCell* cell)
+    {
+    double bounds[6];
+    cell->GetBounds(bounds);
+    return (this->ABoxFrustumIsect(bounds, cell) > 0);
+    }
+
+  // Description:
+  // Returns true if the point is inside the frustum.
+  bool PointInside(double x[3])
+    {
+    return (this->Frustum->EvaluateFunction(x) < 0.0);
+    }
+
+protected:
+  vtkPVLocatorSelectorFrustum() {}
+  ~vtkPVLocatorSelectorFrustum() {}
+
+private:
+  vtkPVLocatorSelectorFrustum(const vtkPVLocatorSelectorFrustum&); // Not implemented
+  void operator=(const vtkPVLocatorSelectorFrustum&); // Not implemented
+};
+
+vtkStandardNewMacro(vtkPVLocatorSelectorFrustum);
+vtkCxxRevisionMacro(vtkPVLocatorSelectorFrustum, "$Revision$");
+
+//----------------------------------------------------------------------------
+class vtkPVLocatorSelector::vtkInternals
+{
+public:
+  struct vtkSurface
+    {
+    vtkSmartPointer<vtkAlgorithm> Producer;
+    int PropId;
+    };
+
+  struct vtkCachedLocator
+    {
+    vtkWeakPointer<vtkDataSet> DataSet;
+    vtkSmartPointer<vtkCellLocator> Locator;
+    };
+
+  typedef vtkstd::map<vtkDataSet*, vtkCachedLocator> LocatorsType;
+
+  vtkstd::vector<vtkSurface> Surfaces;
+  LocatorsType Locators;
+
+  // Returns the locator for the dataset, building it only if the dataset
+  // was modified since the last time.
+  vtkCellLocator* GetLocator(vtkDataSet* ds)
+    {
+    vtkCachedLocator& item = this->Locators[ds];
+    if (!item.Locator || item.DataSet.GetPointer() != ds)
+      {
+      // New dataset, or a new one allocated where a deleted one used to be.
+      item.DataSet = ds;
+      item.Locator = vtkSmartPointer<vtkCellLocator>::New();
+      item.Locator->CacheCellBoundsOn();
+      item.Locator->SetDataSet(ds);
+      }
+    // No-op when the locator is more recent than the dataset.
+    item.Locator->BuildLocator();
+    return item.Locator;
+    }
+
+  // Releases the locators for datasets that have been deleted.
+  void PurgeLocators()
+    {
+    LocatorsType::iterator iter = this->Locators.begin();
+    while (iter != this->Locators.end())
+      {
+      if (iter->second.DataSet.GetPointer() == 0)
+        {
+        this->Locators.erase(iter++);
+        }
+      else
+        {
+        ++iter;
+        }
+      }
+    }
+};
+
+vtkStandardNewMacro(vtkPVLocatorSelector);
+vtkCxxRevisionMacro(vtkPVLocatorSelector, "$Revision$");
+vtkCxxSetObjectMacro(vtkPVLocatorSelector, Controller,
+  vtkMultiProcessController);
+//----------------------------------------------------------------------------
+vtkPVLocatorSelector::vtkPVLocatorSelector()
+{
+  this->SetNumberOfInputPorts(0);
+  this->FieldAssociation = 1;
+  this->PickNearest = 0;
+  for (int cc=0; cc < 32; cc++)
+    {
+    this->Frustum[cc] = 0.0;
+    }
+  this->Controller = 0;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->Internals = new vtkInternals();
+}
+
+//----------------------------------------------------------------------------
+vtkPVLocatorSelector::~vtkPVLocatorSelector()
+{
+  this->SetController(0);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLocatorSelector::AddSurface(vtkAlgorithm* producer, int propId)
+{
+  if (producer)
+    {
+    vtkInternals::vtkSurface surface;
+    surface.Producer = producer;
+    surface.PropId = propId;
+    this->Internals->Surfaces.push_back(surface);
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLocatorSelector::RemoveAllSurfaces()
+{
+  this->Internals->Surfaces.clear();
+  this->Internals->PurgeLocators();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLocatorSelector::SetFrustum(double vertices[32])
+{
+  for (int cc=0; cc < 32; cc++)
+    {
+    this->Frustum[cc] = vertices[cc];
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+static void vtkPVLocatorSelectorAddNode(vtkSelection* output,
+  vtkIdTypeArray* ids, int fieldType, int propId, int processId)
+{
+  vtkSelectionNode* node = vtkSelectionNode::New();
+  node->SetContentType(vtkSelectionNode::INDICES);
+  node->SetFieldType(fieldType);
+  node->GetProperties()->Set(vtkSelectionNode::PROP_ID(), propId);
+  if (processId >= 0)
+    {
+    node->GetProperties()->Set(vtkSelectionNode::PROCESS_ID(), processId);
+    }
+  node->SetSelectionList(ids);
+  output->AddNode(node);
+  node->Delete();
+}
+
+//----------------------------------------------------------------------------
+int vtkPVLocatorSelector::RequestData(vtkInformation*,
+  vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  vtkSelection* output = vtkSelection::GetData(outputVector);
+  output->Initialize();
+
+  int numProcs = this->Controller?
+    this->Controller->GetNumberOfProcesses() : 1;
+  int myId = this->Controller? this->Controller->GetLocalProcessId() : 0;
+  int processId = (numProcs > 1)? myId : -1;
+  bool selectPoints = (this->FieldAssociation == 0);
+  int fieldType = selectPoints?
+    vtkSelectionNode::POINT : vtkSelectionNode::CELL;
+
+  vtkSmartPointer<vtkPVLocatorSelectorFrustum> frustum =
+    vtkSmartPointer<vtkPVLocatorSelectorFrustum>::New();
+  frustum->CreateFrustum(this->Frustum);
+
+  // Only surfaces whose bounds touch the frustum are looked at.
+  vtkstd::vector<vtkDataSet*> datasets;
+  vtkstd::vector<vtkInternals::vtkSurface>::iterator iter;
+  for (iter = this->Internals->Surfaces.begin();
+    iter != this->Internals->Surfaces.end(); ++iter)
+    {
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(
+      iter->Producer->GetOutputDataObject(0));
+    if (ds && ds->GetNumberOfCells() > 0 &&
+      frustum->OverallBoundsTest(ds->GetBounds()))
+      {
+      datasets.push_back(ds);
+      }
+    else
+      {
+      datasets.push_back(0);
+      }
+    }
+
+  vtkGenericCell* cell = vtkGenericCell::New();
+  size_t numSurfaces = datasets.size();
+
+  if (this->PickNearest)
+    {
+    // Cast a ray along the axis of the frustum, from the near plane to the
+    // far plane, and keep the closest hit.
+    double p0[3] = {0.0, 0.0, 0.0};
+    double p1[3] = {0.0, 0.0, 0.0};
+    for (int cc=0; cc < 4; cc++)
+      {
+      for (int kk=0; kk < 3; kk++)
+        {
+        p0[kk] += 0.25 * this->Frustum[8*cc + kk];
+        p1[kk] += 0.25 * this->Frustum[8*cc + 4 + kk];
+        }
+      }
+
+    double bestT = VTK_DOUBLE_MAX;
+    double bestX[3] = {0.0, 0.0, 0.0};
+    vtkIdType bestCell = -1;
+    size_t bestSurface = 0;
+    for (size_t cc=0; cc < numSurfaces; cc++)
+      {
+      if (!datasets[cc])
+        {
+        continue;
+        }
+      double t, x[3], pcoords[3];
+      int subId;
+      vtkIdType cellId = -1;
+      vtkCellLocator* locator = this->Internals->GetLocator(datasets[cc]);
+      if (locator->IntersectWithLine(p0, p1, 0.0, t, x, pcoords, subId,
+          cellId, cell) && cellId >= 0 && t < bestT)
+        {
+        bestT = t;
+        bestCell = cellId;
+        bestSurface = cc;
+        bestX[0] = x[0]; bestX[1] = x[1]; bestX[2] = x[2];
+        }
+      }
+
+    // Only the process with the closest hit reports it.
+    double globalT = bestT;
+    int winner = myId;
+    if (numProcs > 1)
+      {
+      this->Controller->AllReduce(&bestT, &globalT, 1,
+        vtkCommunicator::MIN_OP);
+      int candidate = (bestCell >= 0 && bestT == globalT)? myId : numProcs;
+      this->Controller->AllReduce(&candidate, &winner, 1,
+        vtkCommunicator::MIN_OP);
+      }
+
+    if (globalT < VTK_DOUBLE_MAX)
+      {
+      if (winner == myId && bestCell >= 0)
+        {
+        vtkIdType id = bestCell;
+        if (selectPoints)
+          {
+          // Pick the point of the hit cell closest to the hit.
+          vtkDataSet* ds = datasets[bestSurface];
+          ds->GetCell(bestCell, cell);
+          double minDist2 = VTK_DOUBLE_MAX;
+          for (vtkIdType pt=0; pt < cell->GetNumberOfPoints(); pt++)
+            {
+            double x[3];
+            ds->GetPoint(cell->GetPointId(pt), x);
+            double dist2 = vtkMath::Distance2BetweenPoints(x, bestX);
+            if (dist2 < minDist2)
+              {
+              minDist2 = dist2;
+              id = cell->GetPointId(pt);
+              }
+            }
+          }
+        vtkIdTypeArray* ids = vtkIdTypeArray::New();
+        ids->InsertNextValue(id);
+        vtkPVLocatorSelectorAddNode(output, ids, fieldType,
+          this->Internals->Surfaces[bestSurface].PropId, processId);
+        ids->Delete();
+        }
+      cell->Delete();
+      return 1;
+      }
+    // Nothing was hit by the ray. This is typical of vertices and lines, so
+    // select whatever lies in the (thin) frustum instead.
+    }
+
+  // Candidate cells are those whose bounds overlap the bounds of the
+  // frustum. They are then tested exactly.
+  double bounds[6];
+  frustum->GetClipPoints()->GetBounds(bounds);
+  vtkIdList* candidates = vtkIdList::New();
+  for (size_t cc=0; cc < numSurfaces; cc++)
+    {
+    vtkDataSet* ds = datasets[cc];
+    if (!ds)
+      {
+      continue;
+      }
+    candidates->Reset();
+    this->Internals->GetLocator(ds)->FindCellsWithinBounds(bounds,
+      candidates);
+
+    vtkIdTypeArray* ids = vtkIdTypeArray::New();
+    vtkstd::vector<unsigned char> visited;
+    if (selectPoints)
+      {
+      visited.resize(ds->GetNumberOfPoints(), 0);
+      }
+    vtkIdType numCandidates = candidates->GetNumberOfIds();
+    for (vtkIdType kk=0; kk < numCandidates; kk++)
+      {
+      vtkIdType cellId = candidates->GetId(kk);
+      ds->GetCell(cellId, cell);
+      if (!selectPoints)
+        {
+        if (frustum->CellIntersects(cell))
+          {
+          ids->InsertNextValue(cellId);
+          }
+        continue;
+        }
+      vtkIdType numPts = cell->GetNumberOfPoints();
+      for (vtkIdType pt=0; pt < numPts; pt++)
+        {
+        vtkIdType ptId = cell->GetPointId(pt);
+        if (!visited[ptId])
+          {
+          visited[ptId] = 1;
+          double x[3];
+          ds->GetPoint(ptId, x);
+          if (frustum->PointInside(x))
+            {
+            ids->InsertNextValue(ptId);
+            }
+          }
+        }
+      }
+    if (ids->GetNumberOfTuples() > 0)
+      {
+      vtkPVLocatorSelectorAddNode(output, ids, fieldType,
+        this->Internals->Surfaces[cc].PropId, processId);
+      }
+    ids->Delete();
+    }
+  candidates->Delete();
+  cell->Delete();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLocatorSelector::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "FieldAssociation: " << this->FieldAssociation << endl;
+  os << indent << "PickNearest: " << this->PickNearest << endl;
+  os << indent << "Controller: " << this->Controller << endl;
+}
@@ -0,0 +1,110 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPVLocatorSelector - selects surface cells/points using spatial
+// indices instead of rendering.
+// .SECTION Description
+// vtkPVLocatorSelector is an alternative to vtkPVHardwareSelector that runs
+// on the data server. It is given the algorithms producing the surface data
+// of the visible representations (the geometry filters) together with the
+// vtkClientServerID of the prop rendering each of them. For every surface a
+// vtkCellLocator is built and cached until the surface is modified, and is
+// used to answer the query without any render passes:
+// \li In frustum mode (the default) all cells (or points) of the surfaces
+// inside the frustum are selected. Unlike the hardware selector, occluded
+// cells are selected as well.
+// \li When PickNearest is set, only the cell nearest to the eye along the
+// axis of the frustum is selected, over all surfaces and all processes. This
+// is what a single click selects.
+// The output is a surface selection similar to that produced by
+// vtkPVHardwareSelector i.e. one INDICES node per surface with PROP_ID and
+// PROCESS_ID set.
+// .SECTION See Also
+// vtkPVHardwareSelector vtkCellLocator
+
+#ifndef __vtkPVLocatorSelector_h
+#define __vtkPVLocatorSelector_h
+
+#include "vtkSelectionAlgorithm.h"
+
+class vtkAlgorithm;
+class vtkMultiProcessController;
+
+class VTK_EXPORT vtkPVLocatorSelector : public vtkSelectionAlgorithm
+{
+public:
+  static vtkPVLocatorSelector* New();
+  vtkTypeRevisionMacro(vtkPVLocatorSelector, vtkSelectionAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Add a surface to select from. \c producer is the algorithm whose first
+  // output is the surface dataset, \c propId is the vtkClientServerID of the
+  // prop rendering it and is used as the PROP_ID of the selection nodes.
+  void AddSurface(vtkAlgorithm* producer, int propId);
+
+  // Description:
+  // Removes all surfaces. Locators for surfaces that are no longer alive
+  // are released.
+  void RemoveAllSurfaces();
+
+  // Description:
+  // Set the selection frustum. The eight vertices (x,y,z,w) are in the order
+  // expected by vtkExtractSelectedFrustum::CreateFrustum().
+  void SetFrustum(double vertices[32]);
+
+  // Description:
+  // Set the field to select, 0 for points and 1 for cells (same as
+  // vtkHardwareSelector::FieldAssociation). Default is 1.
+  vtkSetMacro(FieldAssociation, int);
+  vtkGetMacro(FieldAssociation, int);
+
+  // Description:
+  // When set, only the cell nearest to the viewer along the frustum axis is
+  // selected (or its point closest to the hit, when selecting points).
+  // Default is 0.
+  vtkSetMacro(PickNearest, int);
+  vtkGetMacro(PickNearest, int);
+  vtkBooleanMacro(PickNearest, int);
+
+  // Description:
+  // Get/Set the controller used to find the nearest hit over all processes.
+  // Set to the global controller by default.
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+
+//BTX
+protected:
+  vtkPVLocatorSelector();
+  ~vtkPVLocatorSelector();
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector*);
+
+  int FieldAssociation;
+  int PickNearest;
+  double Frustum[32];
+  vtkMultiProcessController* Controller;
+
+private:
+  vtkPVLocatorSelector(const vtkPVLocatorSelector&); // Not implemented
+  void operator=(const vtkPVLocatorSelector&); // Not implemented
+
+  class vtkInternals;
+  vtkInternals* Internals;
+//ETX
+};
+
+#endif
+
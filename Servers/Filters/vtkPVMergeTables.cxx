@@ -16,6 +16,8 @@
 
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetAttributes.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
@@ -24,6 +26,9 @@
 #include "vtkTable.h"
 #include "vtkVariant.h"
 
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
+
 vtkStandardNewMacro(vtkPVMergeTables);
 vtkCxxRevisionMacro(vtkPVMergeTables, "$Revision$");
 //----------------------------------------------------------------------------
@@ -52,9 +57,55 @@ vtkExecutive* vtkPVMergeTables::CreateDefaultExecutive()
   return vtkCompositeDataPipeline::New();
 }
 
+//----------------------------------------------------------------------------
+// vtkTableStreamer passes the rows of each process in sorted order with their
+// "vtkSortKey" when sorting. Interleaves the rows [startRow, end) merged from
+// all processes by the key. Rows of the same key stay in process order.
+static void vtkPVMergeTablesSortRows(vtkTable* output, vtkIdType startRow)
+{
+  vtkDataArray* keys = vtkDataArray::SafeDownCast(
+    output->GetColumnByName("vtkSortKey"));
+  vtkIdType numRows = output->GetNumberOfRows();
+  if (!keys || numRows - startRow < 2)
+    {
+    return;
+    }
+
+  vtkstd::vector<vtkstd::pair<double, vtkIdType> > order;
+  order.reserve(numRows - startRow);
+  for (vtkIdType row = startRow; row < numRows; row++)
+    {
+    order.push_back(vtkstd::pair<double, vtkIdType>(
+        keys->GetComponent(row, 0), row));
+    }
+  vtkstd::sort(order.begin(), order.end());
+
+  vtkIdType numCols = output->GetNumberOfColumns();
+  for (vtkIdType j = 0; j < numCols; j++)
+    {
+    vtkAbstractArray* column = output->GetColumn(j);
+    vtkAbstractArray* sorted = column->NewInstance();
+    sorted->SetName(column->GetName());
+    sorted->SetNumberOfComponents(column->GetNumberOfComponents());
+    sorted->SetNumberOfTuples(numRows);
+    for (vtkIdType row = 0; row < startRow; row++)
+      {
+      sorted->SetTuple(row, row, column);
+      }
+    for (vtkIdType row = startRow; row < numRows; row++)
+      {
+      sorted->SetTuple(row, order[row - startRow].second, column);
+      }
+    // Replaces the column of the same name.
+    output->GetRowData()->AddArray(sorted);
+    sorted->Delete();
+    }
+}
+
 //----------------------------------------------------------------------------
 static void vtkPVMergeTablesMerge(vtkTable* output, vtkTable* inputs[], int num_inputs)
 {
+  vtkIdType startRow = output->GetNumberOfRows();
   for (int idx = 0; idx < num_inputs; ++idx)
     {
     vtkTable* curTable = inputs[idx];
@@ -82,6 +133,7 @@ static void vtkPVMergeTablesMerge(vtkTable* output, vtkTable* inputs[], int num_
         }
       }
     }
+  ::vtkPVMergeTablesSortRows(output, startRow);
 }
 
 //----------------------------------------------------------------------------
@@ -104,6 +156,7 @@ int vtkPVMergeTables::RequestData(
       }
     ::vtkPVMergeTablesMerge(outputTable, inputs, num_connections);
     delete [] inputs;
+    outputTable->RemoveColumnByName("vtkSortKey");
     return 1;
     }
 
@@ -137,6 +190,7 @@ int vtkPVMergeTables::RequestData(
     delete [] inputs;
     }
   iter->Delete();
+  outputTable->RemoveColumnByName("vtkSortKey");
   return 1;
 }
 
@@ -23,15 +23,18 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkProcessGroup.h"
 #include "vtkProcessModule.h"
 #include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vtksys/ios/fstream>
 #include <vtksys/ios/sstream>
 #include <vtksys/SystemTools.hxx>
 
 #include <vtkstd/string>
+#include <vtkstd/vector>
 
 vtkStandardNewMacro(vtkParallelSerialWriter);
 vtkCxxRevisionMacro(vtkParallelSerialWriter, "$Revision$");
@@ -56,6 +59,7 @@ vtkParallelSerialWriter::vtkParallelSerialWriter()
   this->PostGatherHelper = 0;
 
   this->WriteAllTimeSteps = 0;
+  this->NumberOfAggregators = 0;
   this->NumberOfTimeSteps = 0;
   this->CurrentTimeIndex = 0;
 }
@@ -220,8 +224,21 @@ void vtkParallelSerialWriter::WriteATimestep(vtkDataObject* input)
 //----------------------------------------------------------------------------
 void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* input)
 {
-  vtkMultiProcessController* controller = 
+  vtkMultiProcessController* globalController = 
     vtkProcessModule::GetProcessModule()->GetController();
+  int numProcs = globalController->GetNumberOfProcesses();
+
+  // When aggregating, the data is only gathered within the group of this
+  // process.
+  int numGroups = this->NumberOfAggregators < numProcs?
+    this->NumberOfAggregators : numProcs;
+  int groupIndex = 0;
+  vtkSmartPointer<vtkMultiProcessController> controller = globalController;
+  if (numGroups > 1)
+    {
+    controller.TakeReference(
+      this->NewGroupController(globalController, numGroups, groupIndex));
+    }
   
   vtkSmartPointer<vtkReductionFilter> md = vtkSmartPointer<vtkReductionFilter>::New();
   md->SetController(controller);
@@ -243,6 +260,21 @@ void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* in
     vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(),
     this->GhostLevel);
   md->Update();
+
+  int written = 0;
+  vtkstd::string path = vtksys::SystemTools::GetFilenamePath(filename);
+  vtkstd::string fnamenoext =
+    vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
+  vtkstd::string ext = vtksys::SystemTools::GetFilenameLastExtension(filename);
+  vtksys_ios::ostringstream basename;
+  if (this->WriteAllTimeSteps)
+    {
+    basename << path << "/" << fnamenoext << "." << this->CurrentTimeIndex << ext;
+    }
+  else
+    {
+    basename << filename;
+    }
     
   if (controller->GetLocalProcessId() == 0)
     {
@@ -255,26 +287,103 @@ void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* in
       outputCopy->ShallowCopy(output);
 
       vtksys_ios::ostringstream fname;
-      if (this->WriteAllTimeSteps)
+      if (numGroups > 1)
         {
-        vtkstd::string path = 
-          vtksys::SystemTools::GetFilenamePath(filename);
-        vtkstd::string fnamenoext =
-          vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
-        vtkstd::string ext =
-          vtksys::SystemTools::GetFilenameLastExtension(filename);
-        fname << path << "/" << fnamenoext << "." << this->CurrentTimeIndex << ext;
+        fname << vtksys::SystemTools::GetFilenamePath(basename.str()) << "/"
+          << vtksys::SystemTools::GetFilenameWithoutLastExtension(
+            basename.str())
+          << "_" << groupIndex << ext;
         }
       else
         {
-        fname << filename;
+        fname << basename.str();
         }
       this->Writer->SetInputConnection(outputCopy->GetProducerPort());
       this->SetWriterFileName(fname.str().c_str());
       this->WriteInternal();
       this->Writer->SetInputConnection(0);
+      written = 1;
+      }
+    }
+
+  if (numGroups <= 1)
+    {
+    return;
+    }
+
+  // Write the index of the files written by the groups.
+  vtkstd::vector<int> allWritten(numProcs, 0);
+  globalController->Gather(&written, &allWritten[0], 1, 0);
+  if (globalController->GetLocalProcessId() == 0)
+    {
+    vtkstd::string indexName = basename.str() + ".index";
+    vtksys_ios::ofstream index(indexName.c_str());
+    if (!index)
+      {
+      vtkErrorMacro("Cannot open index file " << indexName.c_str());
+      return;
+      }
+    // Only the first process of a group writes, so the group indices follow
+    // from the order of the processes.
+    int group = -1;
+    for (int procId = 0; procId < numProcs; procId++)
+      {
+      if (procId == (group + 1) * numProcs / numGroups)
+        {
+        group++;
+        if (allWritten[procId])
+          {
+          index << vtksys::SystemTools::GetFilenameWithoutLastExtension(
+            vtksys::SystemTools::GetFilenameName(basename.str()))
+            << "_" << group << ext << endl;
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkMultiProcessController* vtkParallelSerialWriter::NewGroupController(
+  vtkMultiProcessController* controller, int numberOfGroups, int& groupIndex)
+{
+  // Group i has the processes [i*numProcs/numberOfGroups,
+  // (i+1)*numProcs/numberOfGroups).
+  int numProcs = controller->GetNumberOfProcesses();
+  int myId = controller->GetLocalProcessId();
+  groupIndex = 0;
+  while (myId >= (groupIndex + 1) * numProcs / numberOfGroups)
+    {
+    groupIndex++;
+    }
+
+  // CreateSubController() is collective over all the processes of the
+  // controller and needs the same group on all of them, so every process
+  // creates the controllers of all the groups in the same order and keeps
+  // the one of its own group.
+  vtkSmartPointer<vtkProcessGroup> group =
+    vtkSmartPointer<vtkProcessGroup>::New();
+  group->Initialize(controller);
+  vtkMultiProcessController* subcontroller = 0;
+  for (int index = 0; index < numberOfGroups; index++)
+    {
+    group->RemoveAllProcessIds();
+    for (int procId = index * numProcs / numberOfGroups;
+      procId < (index + 1) * numProcs / numberOfGroups; procId++)
+      {
+      group->AddProcessId(procId);
+      }
+    vtkMultiProcessController* groupController =
+      controller->CreateSubController(group);
+    if (index == groupIndex)
+      {
+      subcontroller = groupController;
+      }
+    else if (groupController)
+      {
+      groupController->Delete();
       }
     }
+  return subcontroller;
 }
 
 //----------------------------------------------------------------------------
@@ -340,4 +449,5 @@ void vtkParallelSerialWriter::SetWriterFileName(const char* fname)
 void vtkParallelSerialWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfAggregators: " << this->NumberOfAggregators << endl;
 }
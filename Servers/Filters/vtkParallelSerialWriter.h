@@ -20,12 +20,17 @@
 // and PostGatherHelper.
 // This also makes it possible to write time-series for temporal datasets using
 // simple non-time-aware writers.
+// When NumberOfAggregators is greater than 1, the processes are split into
+// that many groups instead and each group writes its own file, so that no
+// process has to hold all the data and the files are written concurrently.
 
 #ifndef __vtkParallelSerialWriter_h
 #define __vtkParallelSerialWriter_h
 
 #include "vtkDataObjectAlgorithm.h"
 
+class vtkMultiProcessController;
+
 class VTK_EXPORT vtkParallelSerialWriter : public vtkDataObjectAlgorithm
 {
 public:
@@ -94,6 +99,19 @@ public:
   vtkSetMacro(WriteAllTimeSteps, int);
   vtkBooleanMacro(WriteAllTimeSteps, int);
 
+  // Description:
+  // Get/Set the number of processes that write files. When 0 (the default)
+  // or 1, the data of all processes is gathered to the first process which
+  // writes a single file named FileName, and no index file is written.
+  // Otherwise, the processes are split into that many groups of consecutive
+  // ranks. The data of each group is gathered to its first
+  // process which writes it to a file named after FileName with the group
+  // index appended (e.g. data_2.csv). The first process also writes an index
+  // file (FileName with .index appended) listing the files that were
+  // written, one per line. The value is limited to the number of processes.
+  vtkSetClampMacro(NumberOfAggregators, int, 0, VTK_LARGE_INTEGER);
+  vtkGetMacro(NumberOfAggregators, int);
+
 protected:
   vtkParallelSerialWriter();
   ~vtkParallelSerialWriter();
@@ -118,6 +136,12 @@ private:
   void SetWriterFileName(const char* fname);
   void WriteInternal();
 
+  // Returns a new controller for the processes of the group of the local
+  // process and sets the index of that group. This is collective: all the
+  // processes of the controller must call it with the same numberOfGroups.
+  vtkMultiProcessController* NewGroupController(
+    vtkMultiProcessController* controller, int numberOfGroups, int& groupIndex);
+
   vtkAlgorithm* PreGatherHelper;
   vtkAlgorithm* PostGatherHelper;
 
@@ -128,6 +152,7 @@ private:
   int GhostLevel;
 
   int WriteAllTimeSteps;
+  int NumberOfAggregators;
   int NumberOfTimeSteps;
   int CurrentTimeIndex;
 
@@ -38,6 +38,7 @@ vtkCxxSetObjectMacro(vtkPhastaReader, CachedGrid, vtkUnstructuredGrid);
 #include <vtkstd/vector>
 #include <vtkstd/string>
 #include <vtksys/ios/sstream>
+#include <vtksys/SystemTools.hxx>
 
 struct vtkPhastaReaderInternal
 {
@@ -74,6 +75,55 @@ int Wrong_Endian = 0 ;
 int Strict_Error = 0 ;
 int binary_format = 0;
 
+// Headers of a binary file, in the order of the file: the text before the
+// colon, the integers following the block size and the offset of the data
+// block. The index of a file is shared by the handles open on it, as long as
+// the file is not modified, and is released when the last of them is closed.
+struct vtkPhastaReaderHeader
+{
+  vtkstd::string Key;
+  vtkstd::vector<int> Params;
+  long DataOffset;
+};
+
+struct vtkPhastaReaderHeaderIndex
+{
+  unsigned long FileLength;
+  long ModifiedTime;
+  int WrongEndian;
+  int ReferenceCount;
+  vtkstd::vector<vtkPhastaReaderHeader> Headers;
+};
+
+static vtkstd::map< vtkstd::string, vtkPhastaReaderHeaderIndex* > HeaderIndices;
+static vtkstd::vector< vtkstd::string > fileNames;
+static vtkstd::vector< vtkPhastaReaderHeaderIndex* > headerIndex;
+static vtkstd::vector< size_t > headerCursor;
+
+// Releases the header index used by a handle, deleting it when no other
+// handle uses it.
+static void releaseHeaderIndex( int filePtr )
+{
+  vtkPhastaReaderHeaderIndex* index = headerIndex[ filePtr ];
+  if ( !index )
+    {
+    return;
+    }
+  headerIndex[ filePtr ] = NULL;
+  headerCursor[ filePtr ] = 0;
+  if ( --index->ReferenceCount > 0 )
+    {
+    return;
+    }
+  vtkstd::map< vtkstd::string, vtkPhastaReaderHeaderIndex* >::iterator it =
+    HeaderIndices.find( fileNames[ filePtr ] );
+  if ( it != HeaderIndices.end() && it->second == index )
+    {
+    HeaderIndices.erase( it );
+    }
+  delete index;
+}
+
 // the caller has the responsibility to delete the returned string 
 char* vtkPhastaReader::StringStripper( const char  istring[] ) 
 {
@@ -317,6 +367,9 @@ void vtkPhastaReader::openfile( const char filename[],
     fileArray.push_back( file );
     byte_order.push_back( 0 );         
     header_type.push_back( sizeof(int) );
+    fileNames.push_back( fname );
+    headerIndex.push_back( NULL );
+    headerCursor.push_back( 0 );
     *fileDescriptor = fileArray.size();
     }
   delete [] imode;
@@ -334,6 +387,7 @@ void vtkPhastaReader::closefile( int* fileDescriptor,
     } 
 
   fclose( fileArray[ *fileDescriptor - 1 ] );
+  releaseHeaderIndex( *fileDescriptor - 1 );
   delete [] imode;
 }
 
@@ -370,10 +424,19 @@ void vtkPhastaReader::readheader( int* fileDescriptor,
   // on the header line.
 
   valueListInt = static_cast< int* >( valueArray );
-  int ierr = readHeader( fileObject ,
-                         keyphrase,
-                         valueListInt,
-                         *nItems ) ;
+  int ierr;
+  if ( binary_format && indexHeaders( filePtr ) )
+    {
+    ierr = findHeader( filePtr, keyphrase, valueListInt, *nItems );
+    Wrong_Endian = headerIndex[ filePtr ]->WrongEndian;
+    }
+  else
+    {
+    ierr = readHeader( fileObject ,
+                       keyphrase,
+                       valueListInt,
+                       *nItems ) ;
+    }
 
   byte_order[ filePtr ] = Wrong_Endian ;
 
@@ -466,6 +529,133 @@ void vtkPhastaReader::readdatablock( int*  fileDescriptor,
 
 // End of copy from phastaIO
 
+// Returns the header index of a binary file, scanning the headers of the
+// file once if they are not known yet.
+vtkPhastaReaderHeaderIndex* vtkPhastaReader::indexHeaders( int filePtr )
+{
+  if ( headerIndex[ filePtr ] )
+    {
+    return headerIndex[ filePtr ];
+    }
+
+  const char* fname = fileNames[ filePtr ].c_str();
+  unsigned long fileLength = vtksys::SystemTools::FileLength( fname );
+  long modifiedTime = vtksys::SystemTools::ModifiedTime( fname );
+  vtkPhastaReaderHeaderIndex*& shared = HeaderIndices[ fileNames[ filePtr ] ];
+  if ( shared &&
+       shared->FileLength == fileLength &&
+       shared->ModifiedTime == modifiedTime )
+    {
+    shared->ReferenceCount++;
+    headerIndex[ filePtr ] = shared;
+    return shared;
+    }
+
+  // An outdated index is left to the handles still using it.
+  vtkPhastaReaderHeaderIndex* index = new vtkPhastaReaderHeaderIndex;
+  index->FileLength = fileLength;
+  index->ModifiedTime = modifiedTime;
+  index->WrongEndian = 0;
+  index->ReferenceCount = 1;
+
+  FILE* fileObject = fileArray[ filePtr ];
+  char Line[1024];
+  int integer_value;
+  char junk;
+
+  rewind( fileObject );
+  while( fgets( Line, 1024, fileObject ) )
+    {
+    int real_length;
+    if ( ( Line[0] == '\n' ) || !( real_length = strcspn( Line, "#" ) ) )
+      {
+      continue;
+      }
+    vtkstd::vector<char> text_header( Line, Line + real_length );
+    text_header.push_back( '\0' );
+    char* token = strtok( &text_header[0], ":" );
+    if ( !token )
+      {
+      continue;
+      }
+    if ( cscompare( token, "byteorder magic number" ) )
+      {
+      fread( (void*)&integer_value, sizeof(int), 1, fileObject );
+      fread( &junk, sizeof(char), 1 , fileObject );
+      if ( 362436 != integer_value )
+        {
+        index->WrongEndian = 1;
+        }
+      continue;
+      }
+
+    vtkPhastaReaderHeader header;
+    header.Key = token;
+    token = strtok( NULL, " ,;<>\r\n" );
+    int skip_size = token ? atoi( token ) : 0;
+    while( ( token = strtok( NULL, " ,;<>\r\n" ) ) )
+      {
+      header.Params.push_back( atoi( token ) );
+      }
+    header.DataOffset = ftell( fileObject );
+    index->Headers.push_back( header );
+    if ( skip_size > 0 )
+      {
+      fseek( fileObject, skip_size, SEEK_CUR );
+      }
+    }
+  clearerr( fileObject );
+  rewind( fileObject );
+
+  if ( index->Headers.empty() )
+    {
+    delete index;
+    if ( !shared )
+      {
+      HeaderIndices.erase( fileNames[ filePtr ] );
+      }
+    return NULL;
+    }
+  shared = index;
+  headerIndex[ filePtr ] = index;
+  return index;
+}
+
+// Same as readHeader() using the header index: headers are searched from the
+// one following the last header found, wrapping around at the end of the
+// file, and the file is positioned at the data block of the header found.
+int vtkPhastaReader::findHeader( int         filePtr,
+                                 const char  phrase[],
+                                 int*        params,
+                                 int         expect )
+{
+  vtkPhastaReaderHeaderIndex* index = headerIndex[ filePtr ];
+  size_t numHeaders = index->Headers.size();
+  for( size_t n=0; n < numHeaders; n++ )
+    {
+    size_t idx = ( headerCursor[ filePtr ] + n ) % numHeaders;
+    const vtkPhastaReaderHeader& header = index->Headers[ idx ];
+    if ( cscompare( phrase, header.Key.c_str() ) )
+      {
+      int i;
+      for( i=0; i < expect && i < (int)header.Params.size(); i++ )
+        {
+        params[i] = header.Params[i];
+        }
+      if ( i < expect )
+        {
+        fprintf(stderr,"Expected # of ints not found for: %s\n",phrase );
+        }
+      fseek( fileArray[ filePtr ], header.DataOffset, SEEK_SET );
+      headerCursor[ filePtr ] = idx + 1;
+      return 0;
+      }
+    }
+
+  fprintf(stderr, "Error: Cound not find: %s\n", phrase);
+  return 1;
+}
+
 
 vtkPhastaReader::vtkPhastaReader()
 {
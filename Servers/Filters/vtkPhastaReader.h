@@ -31,6 +31,7 @@ class vtkInformationVector;
 
 //BTX
 struct vtkPhastaReaderInternal;
+struct vtkPhastaReaderHeaderIndex;
 //ETX
 
 class VTK_EXPORT vtkPhastaReader : public vtkUnstructuredGridAlgorithm
@@ -121,6 +122,13 @@ private:
                              int*  nItems,
                              const char  datatype[],
                              const char  iotype[] );
+//BTX
+  static vtkPhastaReaderHeaderIndex* indexHeaders( int filePtr );
+  static int findHeader( int         filePtr,
+                         const char  phrase[],
+                         int*        params,
+                         int         expect );
+//ETX
 
 
   
@@ -26,6 +26,7 @@
 #include "vtkPythonProgrammableFilter.h"
 #include "vtkCellData.h"
 #include "vtkProcessModule.h"
+#include "vtkWeakPointer.h"
 
 #include <vtksys/SystemTools.hxx>
 #include <vtkstd/algorithm>
@@ -35,7 +36,12 @@
 vtkCxxRevisionMacro(vtkPythonCalculator, "$Revision$");
 vtkStandardNewMacro(vtkPythonCalculator);
 
-//----------------------------------------------------------------------------
+// The function script defined by the last Exec() call and the interpretor
+// it was defined in. Defining it again is skipped when it did not change,
+// which is the common case when the calculator executes once per block of
+// a composite input.
+static vtkWeakPointer<vtkPVPythonInterpretor> vtkPythonCalculatorInterpretor;
+static vtkstd::string vtkPythonCalculatorFunction;
 
 //----------------------------------------------------------------------------
 vtkPythonCalculator::vtkPythonCalculator()
@@ -151,10 +157,14 @@ void vtkPythonCalculator::Exec(const char* expression,
     
   //size_t pos = orgscript.rfind("\n");
     
-  // Construct a script that defines a function
+  // Construct a script that defines a function. The name is prefixed so
+  // that the function does not clash with the ones defined by
+  // vtkPythonProgrammableFilter in the same interpretor.
+  vtkstd::string fname = "vtkPythonCalculator_";
+  fname += funcname;
   vtkstd::string fscript;
   fscript  = "def ";
-  fscript += funcname;
+  fscript += fname;
 
   fscript += "(self, inputs):\n";
   fscript += "  arrays = {}\n";
@@ -223,7 +233,18 @@ void vtkPythonCalculator::Exec(const char* expression,
     fscript += "  return None\n";
     }
   
-  vtkPythonProgrammableFilter::GetGlobalPipelineInterpretor()->RunSimpleString(fscript.c_str());
+  vtkPVPythonInterpretor* interpretor =
+    vtkPythonProgrammableFilter::GetGlobalPipelineInterpretor();
+  if (vtkPythonCalculatorInterpretor.GetPointer() != interpretor ||
+    vtkPythonCalculatorFunction != fscript)
+    {
+    // Forget the previous function first, so that it is not called when
+    // the new one fails to compile.
+    interpretor->RunSimpleString((fname + " = None\n").c_str());
+    interpretor->RunSimpleString(fscript.c_str());
+    vtkPythonCalculatorInterpretor = interpretor;
+    vtkPythonCalculatorFunction = fscript;
+    }
 
   vtkstd::string runscript;
   runscript += "from paraview import vtk\n";
@@ -273,7 +294,7 @@ void vtkPythonCalculator::Exec(const char* expression,
     runscript += "output.GetCellData().PassData(inputs[0].GetCellData().VTKObject)\n";
     }
   runscript += "retVal = ";
-  runscript += funcname;
+  runscript += fname;
   runscript += "(vtk.vtkProgrammableFilter('";
   runscript += aplus;
   runscript += "'), inputs)\n";
@@ -287,8 +308,8 @@ void vtkPythonCalculator::Exec(const char* expression,
   runscript += "del retVal\n";
   runscript += "del output\n";
   
-  vtkPythonProgrammableFilter::GetGlobalPipelineInterpretor()->RunSimpleString(runscript.c_str());
-  vtkPythonProgrammableFilter::GetGlobalPipelineInterpretor()->FlushMessages();
+  interpretor->RunSimpleString(runscript.c_str());
+  interpretor->FlushMessages();
 }
 
 //----------------------------------------------------------------------------
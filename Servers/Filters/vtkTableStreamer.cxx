@@ -16,7 +16,9 @@
 
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
+#include "vtkCommunicator.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -30,6 +32,33 @@
 #include "vtkTable.h"
 #include "vtkUnsignedIntArray.h"
 
+#include <vtkstd/algorithm>
+#include <vtkstd/string>
+#include <math.h>
+
+class vtkTableStreamer::vtkInternals
+{
+public:
+  // Rows of a leaf node sorted by (key, row id). Kept until the sort column
+  // or the sort settings change, so that fetching other blocks does not sort
+  // again.
+  struct SortedLeaf
+    {
+    vtkAbstractArray* Column;
+    unsigned long ColumnMTime;
+    vtkIdType NumberOfRows;
+    int Component;
+    int Descending;
+    vtkstd::vector<double> Keys;
+    vtkstd::vector<vtkIdType> Ids;
+    SortedLeaf() : Column(0), ColumnMTime(0), NumberOfRows(-1),
+      Component(-1), Descending(0) {}
+    };
+
+  vtkstd::string SortColumnName;
+  vtkstd::vector<SortedLeaf> SortedLeaves;
+};
+
 static void vtkFillComponent(vtkUnsignedIntArray* array,
   int component, unsigned int value)
 {
@@ -41,6 +70,156 @@ static void vtkFillComponent(vtkUnsignedIntArray* array,
     ptr[cc] = value;
     }
 }
+
+//----------------------------------------------------------------------------
+static double vtkTableStreamerGetKey(vtkDataArray* array, vtkIdType row,
+  int component, int descending)
+{
+  double key = 0.0;
+  int numComps = array->GetNumberOfComponents();
+  if (numComps == 1 || (component >= 0 && component < numComps))
+    {
+    key = array->GetComponent(row, numComps == 1? 0 : component);
+    }
+  else
+    {
+    for (int cc=0; cc < numComps; cc++)
+      {
+      double value = array->GetComponent(row, cc);
+      key += value*value;
+      }
+    key = sqrt(key);
+    }
+  if (descending)
+    {
+    key = -key;
+    }
+  // NaNs are sorted last.
+  return (key != key)? VTK_DOUBLE_MAX : key;
+}
+
+//----------------------------------------------------------------------------
+// Compares the (key, process id) of proposals gathered by
+// vtkTableStreamerSelect(), which are (key, process id, position, weight).
+class vtkTableStreamerProposalLess
+{
+public:
+  const double* Proposals;
+  vtkTableStreamerProposalLess(const double* proposals)
+    : Proposals(proposals) {}
+  bool operator()(int a, int b) const
+    {
+    const double* pa = this->Proposals + 4*a;
+    const double* pb = this->Proposals + 4*b;
+    return pa[0] < pb[0] || (pa[0] == pb[0] && pa[1] < pb[1]);
+    }
+};
+
+//----------------------------------------------------------------------------
+// Given the sorted keys of the local rows, returns how many of them are among
+// the \c k first rows over all processes, ordering rows by (key, process id,
+// position). This must be called by all processes with the same \c k. The
+// range of candidate rows is narrowed around a pivot chosen as the weighted
+// median of the median of the candidates of each process, so that only a
+// few collective operations on a handful of values are needed, whatever the
+// number of rows.
+static vtkIdType vtkTableStreamerSelect(vtkMultiProcessController* controller,
+  const vtkstd::vector<double>& keys, vtkIdType k)
+{
+  vtkIdType numKeys = static_cast<vtkIdType>(keys.size());
+  int numProcs = controller? controller->GetNumberOfProcesses() : 1;
+  if (numProcs <= 1)
+    {
+    return (k < numKeys)? k : numKeys;
+    }
+  int myId = controller->GetLocalProcessId();
+
+  vtkstd::vector<double> proposals(4*numProcs);
+  vtkstd::vector<int> order;
+  vtkIdType l = 0, r = numKeys;
+  while (true)
+    {
+    vtkIdType active = r - l, total = 0;
+    controller->AllReduce(&active, &total, 1, vtkCommunicator::SUM_OP);
+    if (k <= 0)
+      {
+      return l;
+      }
+    if (k >= total)
+      {
+      return r;
+      }
+
+    double proposal[4] = { 0.0, static_cast<double>(myId), 0.0, 0.0 };
+    if (r > l)
+      {
+      vtkIdType median = l + (r - l)/2;
+      proposal[0] = keys[median];
+      proposal[2] = static_cast<double>(median);
+      proposal[3] = static_cast<double>(r - l);
+      }
+    controller->AllGather(proposal, &proposals[0], 4);
+
+    order.clear();
+    for (int cc=0; cc < numProcs; cc++)
+      {
+      if (proposals[4*cc+3] > 0)
+        {
+        order.push_back(cc);
+        }
+      }
+    vtkstd::sort(order.begin(), order.end(),
+      vtkTableStreamerProposalLess(&proposals[0]));
+    double weight = 0;
+    const double* pivot = &proposals[4*order.back()];
+    for (size_t cc=0; cc < order.size(); cc++)
+      {
+      weight += proposals[4*order[cc]+3];
+      if (2*weight >= total)
+        {
+        pivot = &proposals[4*order[cc]];
+        break;
+        }
+      }
+
+    // Local candidates before the pivot (lt) and up to the pivot (le).
+    vtkIdType lt, le;
+    int pivotId = static_cast<int>(pivot[1]);
+    if (myId == pivotId)
+      {
+      lt = static_cast<vtkIdType>(pivot[2]);
+      le = lt + 1;
+      }
+    else if (myId < pivotId)
+      {
+      lt = le = static_cast<vtkIdType>(vtkstd::upper_bound(
+          keys.begin() + l, keys.begin() + r, pivot[0]) - keys.begin());
+      }
+    else
+      {
+      lt = le = static_cast<vtkIdType>(vtkstd::lower_bound(
+          keys.begin() + l, keys.begin() + r, pivot[0]) - keys.begin());
+      }
+
+    vtkIdType counts[2] = { lt - l, le - l };
+    vtkIdType globalCounts[2];
+    controller->AllReduce(counts, globalCounts, 2, vtkCommunicator::SUM_OP);
+    if (k < globalCounts[0])
+      {
+      r = lt;
+      }
+    else if (k >= globalCounts[1])
+      {
+      l = le;
+      k -= globalCounts[1];
+      }
+    else
+      {
+      // k is exactly the number of rows before the pivot.
+      return lt;
+      }
+    }
+}
  
 vtkStandardNewMacro(vtkTableStreamer);
 vtkCxxRevisionMacro(vtkTableStreamer, "$Revision$");
@@ -53,12 +232,18 @@ vtkTableStreamer::vtkTableStreamer()
   this->BlockSize = 1024;
   this->Block = 0;
   this->GenerateOriginalIds = 0;
+  this->SortColumnName = 0;
+  this->SortComponent = -1;
+  this->SortDescending = 0;
+  this->Internals = new vtkInternals();
 }
 
 //----------------------------------------------------------------------------
 vtkTableStreamer::~vtkTableStreamer()
 {
   this->SetController(0);
+  this->SetSortColumnName(0);
+  delete this->Internals;
 }
 
 //----------------------------------------------------------------------------
@@ -130,8 +315,18 @@ int vtkTableStreamer::RequestData(vtkInformation*,
   vtkDataObject* inputDO = vtkDataObject::GetData(inputVector[0], 0);
   vtkDataObject* outputDO = vtkDataObject::GetData(outputVector, 0);
 
+  bool sort = this->SortColumnName && this->SortColumnName[0];
   vtkstd::vector<vtkstd::pair<vtkIdType, vtkIdType> > indices;
-  if (!this->DetermineIndicesToPass(inputDO, indices))
+  vtkstd::vector<vtkstd::vector<vtkIdType> > sortedRows;
+  vtkstd::vector<vtkstd::vector<double> > sortKeys;
+  if (sort)
+    {
+    if (!this->DetermineSortedRowsToPass(inputDO, sortedRows, sortKeys))
+      {
+      return 0;
+      }
+    }
+  else if (!this->DetermineIndicesToPass(inputDO, indices))
     {
     return 0;
     }
@@ -163,8 +358,9 @@ int vtkTableStreamer::RequestData(vtkInformation*,
     iter->GoToNextItem(), cc++)
     {
     vtkTable* curTable = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
-    vtkIdType curOffset = indices[cc].first;
-    vtkIdType curCount = indices[cc].second;
+    vtkIdType curOffset = sort? 0 : indices[cc].first;
+    vtkIdType curCount = sort?
+      static_cast<vtkIdType>(sortedRows[cc].size()) : indices[cc].second;
     if (curCount <= 0)
       {
       continue;
@@ -224,10 +420,19 @@ int vtkTableStreamer::RequestData(vtkInformation*,
           iter->GetCurrentMetaData()->Get(vtkSelectionNode::COMPOSITE_INDEX())));
       }
 
+    vtkSmartPointer<vtkDoubleArray> sortKeyArray;
+    if (sort)
+      {
+      sortKeyArray = vtkSmartPointer<vtkDoubleArray>::New();
+      sortKeyArray->SetName("vtkSortKey");
+      sortKeyArray->SetNumberOfComponents(1);
+      sortKeyArray->SetNumberOfTuples(curCount);
+      }
+
     // TODO: add Hierarchical index information.
     for (vtkIdType jj=0; jj < curCount; jj++)
       {
-      vtkIdType inIndex = curOffset+jj;
+      vtkIdType inIndex = sort? sortedRows[cc][jj] : curOffset+jj;
       outTable->GetRowData()->CopyData(
         curTable->GetRowData(), inIndex, jj);
       if (originalIndices)
@@ -243,6 +448,10 @@ int vtkTableStreamer::RequestData(vtkInformation*,
         tuple[2] = (inIndex/(dimensions[0]*dimensions[1]));
         structuredIndices->SetTupleValue(jj, tuple);
         }
+      if (sortKeyArray)
+        {
+        sortKeyArray->SetValue(jj, sortKeys[cc][jj]);
+        }
       }
     if (originalIndices)
       {
@@ -256,6 +465,10 @@ int vtkTableStreamer::RequestData(vtkInformation*,
       {
       outTable->GetRowData()->AddArray(compositeIndex);
       }
+    if (sortKeyArray)
+      {
+      outTable->GetRowData()->AddArray(sortKeyArray);
+      }
     }
   iter->Delete();
     
@@ -410,10 +623,118 @@ bool vtkTableStreamer::DetermineIndicesToPass(vtkDataObject* inputDO,
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkTableStreamer::DetermineSortedRowsToPass(vtkDataObject* inputDO,
+  vtkstd::vector<vtkstd::vector<vtkIdType> >& rows,
+  vtkstd::vector<vtkstd::vector<double> >& keys)
+{
+  vtkstd::vector<vtkIdType> counts;
+  vtkstd::vector<vtkIdType> offsets;
+  if (!this->CountRows(inputDO, counts, offsets))
+    {
+    return false;
+    }
+
+  vtkSmartPointer<vtkCompositeDataSet> input =
+    vtkCompositeDataSet::SafeDownCast(inputDO);
+  if (!input)
+    {
+    vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::New();
+    mb->SetBlock(0, inputDO);
+    input = mb;
+    mb->Delete();
+    }
+
+  if (this->Internals->SortColumnName != this->SortColumnName)
+    {
+    this->Internals->SortColumnName = this->SortColumnName;
+    this->Internals->SortedLeaves.clear();
+    }
+  this->Internals->SortedLeaves.resize(counts.size());
+
+  vtkIdType blockStartIndex = this->Block*this->BlockSize;
+  vtkIdType blockEndIndex = blockStartIndex + this->BlockSize;
+
+  vtkCompositeDataIterator* iter = input->NewIterator();
+  iter->SkipEmptyNodesOff();
+
+  vtkIdType offset = 0;
+  int cc=0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+    iter->GoToNextItem(), cc++)
+    {
+    rows.push_back(vtkstd::vector<vtkIdType>());
+    keys.push_back(vtkstd::vector<double>());
+
+    // Rows [start, end) of this leaf, in sorted order over all processes, are
+    // in the block. All processes agree on these since counts are global.
+    vtkIdType start = blockStartIndex - offset;
+    vtkIdType end = blockEndIndex - offset;
+    start = (start < 0)? 0 : start;
+    end = (end > counts[cc])? counts[cc] : end;
+    offset += counts[cc];
+    if (start >= end)
+      {
+      continue;
+      }
+
+    vtkTable* curTable = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
+    vtkIdType numRows = curTable? curTable->GetNumberOfRows() : 0;
+    vtkAbstractArray* column = curTable?
+      curTable->GetColumnByName(this->SortColumnName) : 0;
+    vtkDataArray* dataColumn = vtkDataArray::SafeDownCast(column);
+
+    vtkInternals::SortedLeaf& leaf = this->Internals->SortedLeaves[cc];
+    if (leaf.Column != column ||
+      (column && leaf.ColumnMTime != column->GetMTime()) ||
+      leaf.NumberOfRows != numRows ||
+      leaf.Component != this->SortComponent ||
+      leaf.Descending != this->SortDescending)
+      {
+      vtkstd::vector<vtkstd::pair<double, vtkIdType> > sorted(numRows);
+      for (vtkIdType row=0; row < numRows; row++)
+        {
+        sorted[row].first = dataColumn?
+          vtkTableStreamerGetKey(dataColumn, row, this->SortComponent,
+            this->SortDescending) : VTK_DOUBLE_MAX;
+        sorted[row].second = row;
+        }
+      vtkstd::sort(sorted.begin(), sorted.end());
+
+      leaf.Column = column;
+      leaf.ColumnMTime = column? column->GetMTime() : 0;
+      leaf.NumberOfRows = numRows;
+      leaf.Component = this->SortComponent;
+      leaf.Descending = this->SortDescending;
+      leaf.Keys.resize(numRows);
+      leaf.Ids.resize(numRows);
+      for (vtkIdType row=0; row < numRows; row++)
+        {
+        leaf.Keys[row] = sorted[row].first;
+        leaf.Ids[row] = sorted[row].second;
+        }
+      }
+
+    vtkIdType lo = vtkTableStreamerSelect(this->Controller, leaf.Keys, start);
+    vtkIdType hi = vtkTableStreamerSelect(this->Controller, leaf.Keys, end);
+    rows[cc].assign(leaf.Ids.begin() + lo, leaf.Ids.begin() + hi);
+    keys[cc].assign(leaf.Keys.begin() + lo, leaf.Keys.begin() + hi);
+    }
+  iter->Delete();
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkTableStreamer::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "Block: " << this->Block << endl;
+  os << indent << "BlockSize: " << this->BlockSize << endl;
+  os << indent << "GenerateOriginalIds: " << this->GenerateOriginalIds << endl;
+  os << indent << "SortColumnName: "
+    << (this->SortColumnName? this->SortColumnName : "(none)") << endl;
+  os << indent << "SortComponent: " << this->SortComponent << endl;
+  os << indent << "SortDescending: " << this->SortDescending << endl;
 }
 
 
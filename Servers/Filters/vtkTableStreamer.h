@@ -15,6 +15,13 @@
 // .NAME vtkTableStreamer - block-based vtkTable streaming filter.
 // .SECTION Description
 // vtkTableStreamer is a block-based vtkTable streaming filter. 
+//
+// When SortColumnName is set, the blocks are made of the rows in the order of
+// the values of that column over all processes instead of the order of the
+// input. Rows are not moved between processes: every process finds, with a
+// distributed selection, which of its own rows belong to the requested block
+// and passes them with an additional "vtkSortKey" column that
+// vtkPVMergeTables uses to interleave the rows of all processes.
 
 #ifndef __vtkTableStreamer_h
 #define __vtkTableStreamer_h
@@ -48,6 +55,25 @@ public:
   vtkSetMacro(GenerateOriginalIds, int);
   vtkGetMacro(GenerateOriginalIds, int);
 
+  // Description:
+  // Get/Set the name of the column to sort the rows by. NULL or empty
+  // (default) leaves the rows in the order of the input. Rows of leaf nodes
+  // without such a numeric column are sorted last.
+  vtkSetStringMacro(SortColumnName);
+  vtkGetStringMacro(SortColumnName);
+
+  // Description:
+  // Get/Set the component of a multi-component sort column to sort by. -1
+  // (default) sorts by the magnitude of the tuples.
+  vtkSetMacro(SortComponent, int);
+  vtkGetMacro(SortComponent, int);
+
+  // Description:
+  // When set, rows are sorted by decreasing values. Default is 0.
+  vtkSetMacro(SortDescending, int);
+  vtkGetMacro(SortDescending, int);
+  vtkBooleanMacro(SortDescending, int);
+
   // Description:
   // Get/Set the MPI controller used for gathering.
   void SetController(vtkMultiProcessController*);
@@ -78,10 +104,21 @@ protected:
   bool DetermineIndicesToPass(vtkDataObject* dObj,
     vtkstd::vector<vtkstd::pair<vtkIdType, vtkIdType> >& result);
 
+  // Description:
+  // Used instead of DetermineIndicesToPass() when sorting. Fills up \c rows
+  // with the ids of the rows of each leaf node that should be passed, in
+  // sorted order, and \c keys with their sort keys.
+  bool DetermineSortedRowsToPass(vtkDataObject* dObj,
+    vtkstd::vector<vtkstd::vector<vtkIdType> >& rows,
+    vtkstd::vector<vtkstd::vector<double> >& keys);
+
 
   vtkIdType Block;
   vtkIdType BlockSize;
   int GenerateOriginalIds;
+  char* SortColumnName;
+  int SortComponent;
+  int SortDescending;
   vtkMultiProcessController* Controller;
 private:
   vtkTableStreamer(const vtkTableStreamer&); // Not implemented
@@ -93,6 +130,9 @@ private:
   // rows). This works in parallel collecting information across all processes.
   bool CountRows(vtkDataObject* dObj, vtkstd::vector<vtkIdType>& counts,
     vtkstd::vector<vtkIdType>& offsets);
+
+  class vtkInternals;
+  vtkInternals* Internals;
 //ETX
 };
 
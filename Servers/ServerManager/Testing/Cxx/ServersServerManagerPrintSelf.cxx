@@ -52,6 +52,7 @@
 #include "vtkSMIntArrayInformationHelper.h"
 #include "vtkSMFileListDomain.h"
 #include "vtkSMFixedTypeDomain.h"
+#include "vtkSMGlyph3DRepresentationProxy.h"
 #include "vtkSMIdTypeVectorProperty.h"
 #include "vtkSMImplicitPlaneProxy.h"
 #include "vtkSMImplicitPlaneRepresentationProxy.h"
@@ -188,6 +189,7 @@ int main(int , char *[])
   c = vtkSMFieldDataDomain::New(); c->Print( cout ); c->Delete();
   c = vtkSMFileListDomain::New(); c->Print( cout ); c->Delete();
   c = vtkSMFixedTypeDomain::New(); c->Print( cout ); c->Delete();
+  c = vtkSMGlyph3DRepresentationProxy::New(); c->Print( cout ); c->Delete();
   c = vtkSMIdTypeVectorProperty::New(); c->Print( cout ); c->Delete();
   c = vtkSMImplicitPlaneProxy::New(); c->Print( cout ); c->Delete();
   c = vtkSMImplicitPlaneRepresentationProxy::New(); c->Print( cout ); c->Delete();
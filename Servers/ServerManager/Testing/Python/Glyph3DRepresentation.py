@@ -0,0 +1,42 @@
+# Test the glyph type of the 3D Glyphs representation.
+
+import SMPythonTesting
+import sys
+from paraview.simple import *
+
+SMPythonTesting.ProcessCommandLineArguments()
+
+sphere = Sphere()
+
+rep = Show(sphere)
+rep.Representation = '3D Glyphs'
+rep.GlyphVectors = ['POINTS', 'Normals']
+rep.GlyphScaleFactor = 0.1
+rep.GlyphType = 'Cone'
+Render()
+
+glyphRep = rep.SMProxy.GetSubProxy("Glyph3DRepresentation")
+if glyphRep.GetGlyphType() != 1:
+    print "ERROR: Glyph type not passed to the representation"
+    sys.exit(1)
+
+mapper = glyphRep.GetSubProxy("Mapper")
+glyphSource = mapper.GetProperty("GlyphInput").GetProxy(0)
+if glyphSource.GetXMLName() != "ConeSource":
+    print "ERROR: Wrong glyph source: %s" % glyphSource.GetXMLName()
+    sys.exit(1)
+
+# A capped cone of resolution 6 has 6 triangles and 1 polygon.
+glyphSource.UpdatePipeline()
+info = glyphSource.GetDataInformation()
+if info.GetNumberOfCells() != 7:
+    print "ERROR: Wrong number of cells in the glyph: %d" % \
+      info.GetNumberOfCells()
+    sys.exit(1)
+
+rep.GlyphType = 'Sphere'
+Render()
+glyphSource = mapper.GetProperty("GlyphInput").GetProxy(0)
+if glyphSource.GetXMLName() != "SphereSource":
+    print "ERROR: Glyph source not replaced: %s" % glyphSource.GetXMLName()
+    sys.exit(1)
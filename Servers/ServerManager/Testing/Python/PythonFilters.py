@@ -38,6 +38,26 @@ if hasnumpy:
         if s_a.GetValue(i*3) != pf_a.GetValue(i):
             raise SMPythonTesting.Error("Extracted component %d does not match original") % i
 
+    # Slices of an array only cover part of the VTK array, so they must not
+    # forward attribute requests to it.
+    from paraview.vtk import dataset_adapter
+    sd = dataset_adapter.WrapDataObject(servermanager.Fetch(s))
+    normals = sd.PointData['Normals']
+    if normals.VTKObject is None or \
+      normals.GetNumberOfTuples() != normals.shape[0]:
+        raise SMPythonTesting.Error("Array does not forward to its VTK array")
+    if normals[:].VTKObject is None:
+        raise SMPythonTesting.Error("View of a whole array lost its VTK array")
+    for view in (normals[:, 0], normals[:5]):
+        if view.VTKObject is not None:
+            raise SMPythonTesting.Error("Slice kept the VTK array of its parent")
+        try:
+            view.GetRange()
+        except AttributeError:
+            pass
+        else:
+            raise SMPythonTesting.Error("Slice forwarded GetRange() to the VTK array")
+
     # if not SMPythonTesting.DoRegressionTesting(ren.SMProxy):
     #     raise SMPythonTesting.Error('Image comparison failed.')
 
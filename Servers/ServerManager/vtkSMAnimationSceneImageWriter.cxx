@@ -14,12 +14,15 @@
 =========================================================================*/
 #include "vtkSMAnimationSceneImageWriter.h"
 
+#include "vtkConditionVariable.h"
 #include "vtkErrorCode.h"
 #include "vtkGenericMovieWriter.h"
 #include "vtkImageData.h"
 #include "vtkImageIterator.h"
 #include "vtkImageWriter.h"
 #include "vtkJPEGWriter.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkObjectFactory.h"
 #include "vtkPNGWriter.h"
@@ -35,7 +38,9 @@
 #endif
 
 #include <vtkstd/algorithm>
+#include <vtkstd/deque>
 #include <vtkstd/string>
+#include <vtkstd/vector>
 #include <vtksys/SystemTools.hxx>
 
 #ifdef _WIN32
@@ -51,6 +56,60 @@
 #  include "vtkPVConfig.h"
 #endif
 
+//-----------------------------------------------------------------------------
+class vtkSMAnimationSceneImageWriter::vtkInternals
+{
+public:
+  // Queued frames hold the only reference to their image. It is released
+  // by the encoder thread that writes the frame.
+  struct vtkFrame
+    {
+    vtkImageData* Image;
+    int Index;
+    };
+
+  vtkstd::deque<vtkFrame> Queue;
+  vtkstd::vector<int> ThreadIds;
+
+  // One image writer per encoder thread.
+  vtkstd::vector<vtkSmartPointer<vtkImageWriter> > ImageWriters;
+
+  vtkSmartPointer<vtkMultiThreader> Threader;
+  vtkSmartPointer<vtkMutexLock> Lock;
+
+  // Signalled when a frame is queued or when the threads must stop.
+  vtkSmartPointer<vtkConditionVariable> FrameQueued;
+
+  // Signalled when a frame is taken off the queue or a thread fails.
+  vtkSmartPointer<vtkConditionVariable> FrameDequeued;
+
+  int NextWriter;
+  int ErrorCode;
+  bool Stop;
+
+  vtkInternals()
+    {
+    this->Threader = vtkSmartPointer<vtkMultiThreader>::New();
+    this->Lock = vtkSmartPointer<vtkMutexLock>::New();
+    this->FrameQueued = vtkSmartPointer<vtkConditionVariable>::New();
+    this->FrameDequeued = vtkSmartPointer<vtkConditionVariable>::New();
+    this->NextWriter = 0;
+    this->ErrorCode = 0;
+    this->Stop = false;
+    }
+};
+
+//-----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkSMAnimationSceneImageWriterThreadStart(
+  void* arg)
+{
+  vtkSMAnimationSceneImageWriter* self =
+    static_cast<vtkSMAnimationSceneImageWriter*>(
+      static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+  self->EncoderThread();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 vtkStandardNewMacro(vtkSMAnimationSceneImageWriter);
 vtkCxxRevisionMacro(vtkSMAnimationSceneImageWriter, "$Revision$");
 vtkCxxSetObjectMacro(vtkSMAnimationSceneImageWriter,
@@ -77,6 +136,10 @@ vtkSMAnimationSceneImageWriter::vtkSMAnimationSceneImageWriter()
   this->Prefix = 0;
   this->Suffix = 0;
   this->FrameRate = 1.0;
+  this->NumberOfEncoderThreads = 0;
+  this->MaximumNumberOfQueuedFrames = 4;
+
+  this->Internals = new vtkInternals();
 
   this->BackgroundColor[0] = this->BackgroundColor[1] =
     this->BackgroundColor[2] = 0.0;
@@ -85,6 +148,9 @@ vtkSMAnimationSceneImageWriter::vtkSMAnimationSceneImageWriter()
 //-----------------------------------------------------------------------------
 vtkSMAnimationSceneImageWriter::~vtkSMAnimationSceneImageWriter()
 {
+  this->StopEncoderThreads();
+  delete this->Internals;
+
   this->SetMovieWriter(0);
   this->SetImageWriter(0);
 
@@ -116,6 +182,12 @@ bool vtkSMAnimationSceneImageWriter::SaveInitialize()
   this->AnimationScene->SetOverrideStillRender(1);
 
   this->FileCount = 0;
+  this->ErrorCode = 0;
+
+  if (this->NumberOfEncoderThreads > 0)
+    {
+    this->StartEncoderThreads();
+    }
 
 #if !defined(__APPLE__)      
   // Iterate over all views and enable offscreen rendering. This avoid toggling
@@ -253,25 +325,56 @@ bool vtkSMAnimationSceneImageWriter::SaveFrame(double vtkNotUsed(time))
     combinedImage.TakeReference(capture);
     }
 
+  if (combinedImage && this->Internals->ThreadIds.size() > 0)
+    {
+    // The encoder threads write the frame while the next one is rendered.
+    // They get the only reference to the image so that its reference count
+    // is never changed by two threads at once.
+    vtkImageData* image = combinedImage;
+    image->Register(this);
+    combinedImage = 0;
+    if (!this->QueueFrame(image))
+      {
+      return false;
+      }
+    this->FileCount++;
+    return true;
+    }
+
+  int errcode = this->WriteFrame(combinedImage, this->FileCount,
+    this->ImageWriter);
+  combinedImage = 0;
+
+  if (errcode)
+    {
+    this->ErrorCode = errcode;
+    return false;
+    }
+  this->FileCount++;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+int vtkSMAnimationSceneImageWriter::WriteFrame(vtkImageData* image,
+  int index, vtkImageWriter* iwriter)
+{
   int errcode = 0;
-  if (this->ImageWriter)
+  if (iwriter)
     {
     char number[1024];
-    sprintf(number, ".%04d", this->FileCount);
+    sprintf(number, ".%04d", index);
     vtkstd::string filename = this->Prefix;
     filename = filename + number + this->Suffix;
-    this->ImageWriter->SetInput(combinedImage);
-    this->ImageWriter->SetFileName(filename.c_str());
-    this->ImageWriter->Write();
-    this->ImageWriter->SetInput(0);
-
-    errcode = this->ImageWriter->GetErrorCode();
-    this->FileCount = (!errcode)? this->FileCount + 1 : this->FileCount;
+    iwriter->SetInput(image);
+    iwriter->SetFileName(filename.c_str());
+    iwriter->Write();
+    iwriter->SetInput(0);
 
+    errcode = iwriter->GetErrorCode();
     }
   else if (this->MovieWriter)
     {
-    this->MovieWriter->SetInput(combinedImage);
+    this->MovieWriter->SetInput(image);
     this->MovieWriter->Write();
     this->MovieWriter->SetInput(0);
 
@@ -298,7 +401,102 @@ bool vtkSMAnimationSceneImageWriter::SaveFrame(double vtkNotUsed(time))
       errcode = alg_error;
       }
     }
-  combinedImage = 0;
+  return errcode;
+}
+
+//-----------------------------------------------------------------------------
+void vtkSMAnimationSceneImageWriter::StartEncoderThreads()
+{
+  vtkInternals* internals = this->Internals;
+  internals->Queue.clear();
+  internals->ImageWriters.clear();
+  internals->NextWriter = 0;
+  internals->ErrorCode = 0;
+  internals->Stop = false;
+
+  // Movie encoders are stateful and must see the frames in order, hence
+  // they get a single thread.
+  int numThreads = this->MovieWriter? 1 :
+    vtkstd::min(this->NumberOfEncoderThreads, VTK_MAX_THREADS);
+  if (this->ImageWriter)
+    {
+    for (int cc=0; cc < numThreads; cc++)
+      {
+      vtkSmartPointer<vtkImageWriter> iwriter;
+      iwriter.TakeReference(this->ImageWriter->NewInstance());
+      internals->ImageWriters.push_back(iwriter);
+      }
+    }
+
+  for (int cc=0; cc < numThreads; cc++)
+    {
+    int id = internals->Threader->SpawnThread(
+      vtkSMAnimationSceneImageWriterThreadStart, this);
+    if (id < 0)
+      {
+      // Whatever threads were started will do the work.
+      break;
+      }
+    internals->ThreadIds.push_back(id);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkSMAnimationSceneImageWriter::StopEncoderThreads()
+{
+  vtkInternals* internals = this->Internals;
+  if (internals->ThreadIds.size() == 0)
+    {
+    return;
+    }
+
+  internals->Lock->Lock();
+  internals->Stop = true;
+  internals->FrameQueued->Broadcast();
+  internals->Lock->Unlock();
+
+  // TerminateThread() joins the thread, which exits once the queue is empty.
+  vtkstd::vector<int>::iterator iter;
+  for (iter = internals->ThreadIds.begin();
+    iter != internals->ThreadIds.end(); ++iter)
+    {
+    internals->Threader->TerminateThread(*iter);
+    }
+  internals->ThreadIds.clear();
+  internals->ImageWriters.clear();
+  internals->Queue.clear();
+
+  if (internals->ErrorCode && !this->ErrorCode)
+    {
+    this->ErrorCode = internals->ErrorCode;
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkSMAnimationSceneImageWriter::QueueFrame(vtkImageData* image)
+{
+  vtkInternals* internals = this->Internals;
+
+  internals->Lock->Lock();
+  while (!internals->ErrorCode && static_cast<int>(internals->Queue.size())
+    >= this->MaximumNumberOfQueuedFrames)
+    {
+    internals->FrameDequeued->Wait(internals->Lock);
+    }
+  int errcode = internals->ErrorCode;
+  if (errcode)
+    {
+    image->UnRegister(this);
+    }
+  else
+    {
+    vtkInternals::vtkFrame frame;
+    frame.Image = image;
+    frame.Index = this->FileCount;
+    internals->Queue.push_back(frame);
+    internals->FrameQueued->Signal();
+    }
+  internals->Lock->Unlock();
 
   if (errcode)
     {
@@ -308,11 +506,62 @@ bool vtkSMAnimationSceneImageWriter::SaveFrame(double vtkNotUsed(time))
   return true;
 }
 
+//-----------------------------------------------------------------------------
+void vtkSMAnimationSceneImageWriter::EncoderThread()
+{
+  vtkInternals* internals = this->Internals;
+
+  internals->Lock->Lock();
+  vtkImageWriter* iwriter = 0;
+  if (internals->NextWriter <
+    static_cast<int>(internals->ImageWriters.size()))
+    {
+    iwriter = internals->ImageWriters[internals->NextWriter];
+    }
+  internals->NextWriter++;
+
+  while (true)
+    {
+    while (internals->Queue.size() == 0 && !internals->Stop)
+      {
+      internals->FrameQueued->Wait(internals->Lock);
+      }
+    if (internals->Queue.size() == 0)
+      {
+      // Asked to stop and nothing left to write.
+      break;
+      }
+
+    vtkInternals::vtkFrame frame = internals->Queue.front();
+    internals->Queue.pop_front();
+    bool failed = (internals->ErrorCode != 0);
+    internals->FrameDequeued->Signal();
+    internals->Lock->Unlock();
+
+    // Once a frame failed, the remaining ones are dropped.
+    int errcode = failed? 0 : this->WriteFrame(frame.Image, frame.Index,
+      iwriter);
+    frame.Image->UnRegister(this);
+
+    internals->Lock->Lock();
+    if (errcode && !internals->ErrorCode)
+      {
+      internals->ErrorCode = errcode;
+      // Wake up the rendering thread if it is waiting for room in the queue.
+      internals->FrameDequeued->Broadcast();
+      }
+    }
+  internals->Lock->Unlock();
+}
+
 //-----------------------------------------------------------------------------
 bool vtkSMAnimationSceneImageWriter::SaveFinalize()
 {
   this->AnimationScene->SetOverrideStillRender(0);
 
+  // Wait for the queued frames to be written.
+  this->StopEncoderThreads();
+
   // TODO: If save failed, we must remove the partially
   // written files.
   if (this->MovieWriter)
@@ -334,7 +583,7 @@ bool vtkSMAnimationSceneImageWriter::SaveFinalize()
       }
     }
 
-  return true;
+  return (this->ErrorCode == 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -458,6 +707,10 @@ void vtkSMAnimationSceneImageWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Subsampling: " << this->Subsampling << endl;
   os << indent << "ErrorCode: " << this->ErrorCode << endl;
   os << indent << "FrameRate: " << this->FrameRate << endl;
+  os << indent << "NumberOfEncoderThreads: " 
+    << this->NumberOfEncoderThreads << endl;
+  os << indent << "MaximumNumberOfQueuedFrames: " 
+    << this->MaximumNumberOfQueuedFrames << endl;
   os << indent << "BackgroundColor: " << this->BackgroundColor[0]
     << ", " << this->BackgroundColor[1] << ", " << this->BackgroundColor[2]
     << endl;
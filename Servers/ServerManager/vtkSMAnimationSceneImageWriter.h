@@ -20,6 +20,11 @@
 // output's size and alignment is exactly as specified on the GUISize,
 // WindowPosition properties of the view modules. One can optionally specify
 // Magnification to scale the output.
+//
+// By default each frame is encoded and written before the next frame is
+// rendered. When NumberOfEncoderThreads is positive, captured frames are
+// instead handed to a bounded queue drained by worker threads, so that
+// encoding and file I/O of one frame overlaps with rendering of the next.
 // .SECTION Notes
 // This class does not support changing the dimensions of the view, one has to 
 // do that before calling Save(). It only provides Magnification which can scale 
@@ -85,12 +90,36 @@ public:
   vtkSetMacro(FrameRate, double);
   vtkGetMacro(FrameRate, double);
 
+  // Description:
+  // Get/Set the number of threads used to encode and write the frames.
+  // When 0, frames are written synchronously as they are rendered. When
+  // positive, frames are queued and written by that many worker threads
+  // while the following frames are rendered. Movies are always encoded by a
+  // single thread so that the frames are written in order. Default is 0.
+  vtkSetClampMacro(NumberOfEncoderThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfEncoderThreads, int);
+
+  // Description:
+  // Get/Set the maximum number of captured frames that may wait to be
+  // written when NumberOfEncoderThreads is positive. Rendering blocks while
+  // the queue is full, which bounds the memory held by pending frames.
+  // Default is 4.
+  vtkSetClampMacro(MaximumNumberOfQueuedFrames, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfQueuedFrames, int);
+
 
   // Description:
   // Convenience method used to merge a smaller image (\c src) into a 
   // larger one (\c dest). The location of the smaller image in the larger image
   // are determined by their extents.
   static void Merge(vtkImageData* dest, vtkImageData* src);
+
+//BTX
+  // Description:
+  // Internal method executed by each encoder thread. It writes queued frames
+  // until the queue is empty and the threads have been asked to stop.
+  void EncoderThread();
+//ETX
 protected:
   vtkSMAnimationSceneImageWriter();
   ~vtkSMAnimationSceneImageWriter();
@@ -124,6 +153,24 @@ protected:
 
   vtkImageData* NewFrame();
 
+  // Description:
+  // Writes a frame using the given image writer (or the movie writer if
+  // there is no image writer). \c index is used to number the image files.
+  // Returns the error code, 0 on success.
+  int WriteFrame(vtkImageData* image, int index, vtkImageWriter* iwriter);
+
+  // Description:
+  // Hands the frame to the encoder threads. Blocks while the queue is full.
+  // The reference held by the caller on \c image is transferred to the
+  // queue. Returns false if an encoder thread has failed.
+  bool QueueFrame(vtkImageData* image);
+
+  // Description:
+  // Start/stop the encoder threads. StopEncoderThreads() returns after all
+  // queued frames have been written.
+  void StartEncoderThreads();
+  void StopEncoderThreads();
+
   vtkSetVector2Macro(ActualSize, int);
   int ActualSize[2];
   int Quality;
@@ -131,6 +178,8 @@ protected:
   int FileCount;
   int ErrorCode;
   int Subsampling;
+  int NumberOfEncoderThreads;
+  int MaximumNumberOfQueuedFrames;
 
   char* Prefix;
   char* Suffix;
@@ -145,6 +194,11 @@ protected:
 
   void SetImageWriter(vtkImageWriter*);
   void SetMovieWriter(vtkGenericMovieWriter*);
+
+//BTX
+  class vtkInternals;
+  vtkInternals* Internals;
+//ETX
 private:
   vtkSMAnimationSceneImageWriter(const vtkSMAnimationSceneImageWriter&); // Not implemented.
   void operator=(const vtkSMAnimationSceneImageWriter&); // Not implemented.
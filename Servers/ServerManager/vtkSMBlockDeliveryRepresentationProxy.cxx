@@ -15,6 +15,7 @@
 #include "vtkSMBlockDeliveryRepresentationProxy.h"
 
 #include "vtkAlgorithm.h"
+#include "vtkCommand.h"
 #include "vtkDataObject.h"
 #include "vtkObjectFactory.h"
 #include "vtkProcessModule.h"
@@ -262,6 +263,20 @@ void vtkSMBlockDeliveryRepresentationProxy::Fetch(vtkIdType block)
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMBlockDeliveryRepresentationProxy::ExecuteSubProxyEvent(
+  vtkSMProxy* o, unsigned long event, void* data)
+{
+  const char* name = reinterpret_cast<const char*>(data);
+  if (o && o == this->Streamer && event == vtkCommand::UpdatePropertyEvent &&
+    name && strcmp(name, "Block") != 0)
+    {
+    // The blocks fetched so far no longer hold the rows they would now hold.
+    this->CacheDirty = true;
+    }
+  this->Superclass::ExecuteSubProxyEvent(o, event, data);
+}
+
 //----------------------------------------------------------------------------
 void vtkSMBlockDeliveryRepresentationProxy::CleanCache()
 {
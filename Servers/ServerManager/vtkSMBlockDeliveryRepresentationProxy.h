@@ -93,6 +93,13 @@ protected:
   // Ensures that the block of data is available on the client.
   void Fetch(vtkIdType block);
 
+  // Description:
+  // Overridden to clean the cache when properties of the Streamer that change
+  // the content of the blocks, such as the block size or the sort settings,
+  // are pushed.
+  virtual void ExecuteSubProxyEvent(vtkSMProxy* o, unsigned long event,
+    void* data);
+
   vtkSMSourceProxy* PreProcessor;
   vtkSMSourceProxy* Streamer;
   vtkSMSourceProxy* Reduction;
@@ -21,6 +21,7 @@
 #include "vtkSmartPointer.h"
 #include "vtkSMCameraLink.h"
 #include "vtkSMDoubleVectorProperty.h"
+#include "vtkSMInputProperty.h"
 #include "vtkSMIntVectorProperty.h"
 #include "vtkSMPropertyIterator.h"
 #include "vtkSMProxyLink.h"
@@ -28,6 +29,7 @@
 #include "vtkSMPropertyHelper.h"
 #include "vtkSMRepresentationProxy.h"
 #include "vtkSMProxyProperty.h"
+#include "vtkSMStringVectorProperty.h"
 
 #include <vtkstd/vector>
 #include <vtkstd/map>
@@ -65,6 +67,9 @@ public:
     this->ViewCameraLink->SynchronizeInteractiveRendersOff();
    }
 
+  // State of each cell when it was last generated, see UpdateCellState().
+  vtkstd::vector<vtkstd::string> CellStates;
+
   unsigned int ActiveIndexX;
   unsigned int ActiveIndexY;
   vtkstd::string SuggestedViewType;
@@ -200,6 +205,10 @@ void vtkSMComparativeViewProxy::Build(int dx, int dy)
     this->SceneOutdated = true;
     }
 
+  if (this->Dimensions[0] != dx || this->Dimensions[1] != dy)
+    {
+    this->Internal->CellStates.clear();
+    }
   this->Dimensions[0] = dx;
   this->Dimensions[1] = dy;
 
@@ -452,6 +461,7 @@ void vtkSMComparativeViewProxy::AddRepresentation(vtkSMRepresentationProxy* repr
   // Add the RepresentationData struct to a map
   // with the original representation as the key
   this->Internal->RepresentationClones[repr] = data;
+  this->Internal->CellStates.clear();
 
   // Signal that representations have changed
   this->InvokeEvent(vtkCommand::UserEvent);
@@ -490,6 +500,7 @@ void vtkSMComparativeViewProxy::RemoveRepresentation(vtkSMRepresentationProxy* r
 
   // This will destroy the repr proxy link as well.
   this->Internal->RepresentationClones.erase(reprDataIter);
+  this->Internal->CellStates.clear();
 
   // Remove repr from RootView.
   vtkSMViewProxy* rootView = this->GetRootView();
@@ -572,15 +583,6 @@ void vtkSMComparativeViewProxy::UpdateVisualization(int force)
     return;
     }
 
-  vtkInternal::VectorOfViews::iterator iter;
-  for (iter = this->Internal->Views.begin(); 
-       iter != this->Internal->Views.end(); ++iter)
-    {
-    iter->GetPointer()->SetUseCache(false);
-    iter->GetPointer()->UpdateAllRepresentations();
-    iter->GetPointer()->SetUseCache(true);
-    }
-
   // Are we in generating a film-strip or a comparative vis?
   if (this->AnimationSceneX && this->AnimationSceneY &&
     this->Mode == COMPARATIVE)
@@ -623,6 +625,10 @@ void vtkSMComparativeViewProxy::UpdateRootView()
     }
   view->SetCacheTime(view->GetCacheTime()+1.0);
   view->StillRender();
+  if (!this->Internal->CellStates.empty())
+    {
+    this->Internal->CellStates[0].clear();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -653,16 +659,20 @@ void vtkSMComparativeViewProxy::UpdateFilmStripVisualization(
 
     vtkSMViewProxy* view = this->Internal->Views[view_index];
 
-    if (this->GetShowTimeSteps())
-      {
-      double time = this->TimeRange[0] + view_index*increment;
-      view->SetViewUpdateTime(time);
-      }
-    else
+    double time = this->GetShowTimeSteps()?
+      this->TimeRange[0] + view_index*increment : this->GetViewUpdateTime();
+    view->SetViewUpdateTime(time);
+    if (!this->UpdateCellState(view_index, time))
       {
-      view->SetViewUpdateTime(this->GetViewUpdateTime());
+      // The view still caches the data for these parameters.
+      continue;
       }
 
+    // Discard the data cached for the previous parameters.
+    view->SetUseCache(false);
+    view->UpdateAllRepresentations();
+    view->SetUseCache(true);
+
     // HACK: This ensure that obsolete cache is never used when the CV is being
     // generated.
     view->SetCacheTime(view->GetCacheTime()+1.0);
@@ -700,16 +710,20 @@ void vtkSMComparativeViewProxy::UpdateComparativeVisualization(
       sceneX->SetAnimationTime(x);
       vtkSMViewProxy* view = this->Internal->Views[view_index];
 
-      if (this->GetShowTimeSteps())
-        {
-        double time = this->TimeRange[0] + view_index*increment;
-        view->SetViewUpdateTime(time);
-        }
-      else
+      double time = this->GetShowTimeSteps()?
+        this->TimeRange[0] + view_index*increment : this->GetViewUpdateTime();
+      view->SetViewUpdateTime(time);
+      if (!this->UpdateCellState(view_index++, time))
         {
-        view->SetViewUpdateTime(this->GetViewUpdateTime());
+        // The view still caches the data for these parameters.
+        continue;
         }
 
+      // Discard the data cached for the previous parameters.
+      view->SetUseCache(false);
+      view->UpdateAllRepresentations();
+      view->SetUseCache(true);
+
       // HACK: This ensure that obsolete cache is never used when the CV is being
       // generated.
       view->SetCacheTime(view->GetCacheTime()+1.0);
@@ -718,11 +732,107 @@ void vtkSMComparativeViewProxy::UpdateComparativeVisualization(
       // We do interactive render so that both the full-res as well as low-res cache
       // is updated.
       view->InteractiveRender();
-      view_index++;
       }
     }
 }
 
+//----------------------------------------------------------------------------
+// Appends the values of the properties of the proxy and, recursively, of the
+// proxies it refers to. Information properties are skipped since they do not
+// determine the output and may change on update.
+static void vtkAppendProxyState(vtkSMProxy* proxy, vtksys_ios::ostream& state,
+  vtkstd::set<vtkSMProxy*>& visited)
+{
+  if (!proxy)
+    {
+    state << "0";
+    return;
+    }
+  state << static_cast<void*>(proxy);
+  if (!visited.insert(proxy).second)
+    {
+    return;
+    }
+
+  state << "{";
+  vtkSmartPointer<vtkSMPropertyIterator> iter;
+  iter.TakeReference(proxy->NewPropertyIterator());
+  for (iter->Begin(); !iter->IsAtEnd(); iter->Next())
+    {
+    vtkSMProperty* prop = iter->GetProperty();
+    if (prop->GetInformationOnly())
+      {
+      continue;
+      }
+    state << iter->GetKey() << "=";
+    vtkSMProxyProperty* pp = vtkSMProxyProperty::SafeDownCast(prop);
+    vtkSMInputProperty* ip = vtkSMInputProperty::SafeDownCast(prop);
+    if (pp)
+      {
+      for (unsigned int cc=0; cc < pp->GetNumberOfProxies(); cc++)
+        {
+        vtkAppendProxyState(pp->GetProxy(cc), state, visited);
+        if (ip)
+          {
+          state << ":" << ip->GetOutputPortForConnection(cc);
+          }
+        state << ",";
+        }
+      }
+    else if (vtkSMVectorProperty::SafeDownCast(prop))
+      {
+      vtkSMPropertyHelper helper(proxy, iter->GetKey());
+      bool isString = (vtkSMStringVectorProperty::SafeDownCast(prop) != 0);
+      for (unsigned int cc=0; cc < helper.GetNumberOfElements(); cc++)
+        {
+        if (isString)
+          {
+          const char* value = helper.GetAsString(cc);
+          state << (value? value : "") << ",";
+          }
+        else
+          {
+          state << helper.GetAsDouble(cc) << ",";
+          }
+        }
+      }
+    state << ";";
+    }
+  state << "}";
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMComparativeViewProxy::UpdateCellState(int index, double time)
+{
+  vtkSMViewProxy* view = this->Internal->Views[index];
+
+  vtksys_ios::ostringstream state;
+  state.precision(17);
+  state << time << "|";
+  vtkSmartPointer<vtkCollection> reprs = vtkSmartPointer<vtkCollection>::New();
+  this->GetRepresentationsForView(view, reprs);
+  vtkstd::set<vtkSMProxy*> visited;
+  for (int cc=0; cc < reprs->GetNumberOfItems(); cc++)
+    {
+    vtkAppendProxyState(vtkSMProxy::SafeDownCast(reprs->GetItemAsObject(cc)),
+      state, visited);
+    state << "|";
+    }
+
+  if (this->Internal->CellStates.size() != this->Internal->Views.size())
+    {
+    this->Internal->CellStates.clear();
+    this->Internal->CellStates.resize(this->Internal->Views.size());
+    }
+  vtkstd::string& cellState = this->Internal->CellStates[index];
+  if (!cellState.empty() && cellState == state.str())
+    {
+    return false;
+    }
+  cellState = state.str();
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMComparativeViewProxy::GetViews(vtkCollection* collection)
 {
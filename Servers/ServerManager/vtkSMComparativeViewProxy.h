@@ -138,6 +138,8 @@ public:
   // Called on every still render. This checks if the comparative visualization
   // needs to be regenerated (following changes to proxies involved in
   // generating the comparative visualization)/tim
+  // Only the cells whose parameters, time or upstream pipeline changed since
+  // they were last generated are generated again.
   void UpdateVisualization(int force=0);
 
   // Description:
@@ -243,6 +245,15 @@ protected:
   // Update timestrip scene.
   void UpdateFilmStripVisualization(vtkSMAnimationSceneProxy* scene);
 
+  // Description:
+  // Records the state determining the content of the cell shown by the view
+  // at \c index for the parameters currently applied i.e. the time \c time
+  // and the values of the properties of its representations and of all the
+  // proxies upstream of them. Returns true when it differs from the state
+  // recorded when the cell was last generated, in which case the cell must be
+  // generated again. Cells of unchanged state keep their cached data.
+  bool UpdateCellState(int index, double time);
+
   // Description:
   // Update layout for internal views.
   void UpdateViewLayout();
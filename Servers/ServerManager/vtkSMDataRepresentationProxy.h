@@ -187,6 +187,13 @@ public:
   virtual vtkSMProxy* GetProcessedConsumer()
     { return 0; }
 
+  // Description:
+  // Returns the prop proxy rendering the output of GetProcessedConsumer(),
+  // if any. Used for selections computed on the data server (see
+  // vtkSMRenderViewProxy::SetUseSpatialIndexSelection).
+  virtual vtkSMProxy* GetProcessedProp3D()
+    { return 0; }
+
   // Description:
   // Returns the data size of the display data. When using LOD this is the
   // low-res data size, else it's same as GetFullResMemorySize().
@@ -27,6 +27,7 @@ vtkCxxRevisionMacro(vtkSMFileSeriesReaderProxy, "$Revision$");
 vtkSMFileSeriesReaderProxy::vtkSMFileSeriesReaderProxy()
 {
   this->FileNameMethod = 0;
+  this->DistributeTimeInformation = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -71,6 +72,12 @@ void vtkSMFileSeriesReaderProxy::CreateVTKObjects()
            << this->GetFileNameMethod()
            << vtkClientServerStream::End;
     }
+  if (this->DistributeTimeInformation)
+    {
+    stream << vtkClientServerStream::Invoke
+           << this->GetID() << "SetDistributeTimeInformation" << 1
+           << vtkClientServerStream::End;
+    }
   pm->SendStream(this->ConnectionID, this->Servers, stream);
 } 
 
@@ -84,6 +91,14 @@ int vtkSMFileSeriesReaderProxy::ReadXMLAttributes(
     this->SetFileNameMethod(setFileNameMethod);
     }
 
+  // Collective, so only for readers whose pipeline information is known to
+  // be updated on all the processes together.
+  int distribute;
+  if (element->GetScalarAttribute("distribute_time_information", &distribute))
+    {
+    this->DistributeTimeInformation = distribute;
+    }
+
   return this->Superclass::ReadXMLAttributes(pm, element);
 }
 
@@ -91,4 +106,6 @@ int vtkSMFileSeriesReaderProxy::ReadXMLAttributes(
 void vtkSMFileSeriesReaderProxy::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DistributeTimeInformation: "
+     << this->DistributeTimeInformation << endl;
 }
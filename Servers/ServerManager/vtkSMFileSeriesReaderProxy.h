@@ -17,7 +17,10 @@
 // vtkSMFileSeriesReaderProxy is used to manager vtkFileSeriesReaders.
 // It creates the internal reader as a sub-proxy and sets it on the
 // meta-reader in CreateVTKObjects(). It also sets FileNameMethod from
-// the xml attribute file_name_method.
+// the xml attribute file_name_method. DistributeTimeInformation is turned
+// on only when the xml attribute distribute_time_information is 1, which is
+// off by default since it requires all the server processes to update the
+// pipeline information together. The VTK XML readers set it.
 // .SECTION See Also
 // vtkFileSeriesReader
 
@@ -50,6 +53,9 @@ protected:
 
   char* FileNameMethod;
 
+  // Set from the xml attribute distribute_time_information.
+  int DistributeTimeInformation;
+
 private:
   vtkSMFileSeriesReaderProxy(const vtkSMFileSeriesReaderProxy&); // Not implemented.
   void operator=(const vtkSMFileSeriesReaderProxy&); // Not implemented.
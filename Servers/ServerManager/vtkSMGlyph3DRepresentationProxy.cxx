@@ -0,0 +1,177 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMGlyph3DRepresentationProxy.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
+#include "vtkSMIntVectorProperty.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSMStringVectorProperty.h"
+
+#include <vtkstd/string>
+
+vtkStandardNewMacro(vtkSMGlyph3DRepresentationProxy);
+vtkCxxRevisionMacro(vtkSMGlyph3DRepresentationProxy, "$Revision$");
+//----------------------------------------------------------------------------
+vtkSMGlyph3DRepresentationProxy::vtkSMGlyph3DRepresentationProxy()
+{
+  this->GlyphType = vtkSMGlyph3DRepresentationProxy::ARROW;
+  this->GlyphSource = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkSMGlyph3DRepresentationProxy::~vtkSMGlyph3DRepresentationProxy()
+{
+  if (this->GlyphSource)
+    {
+    this->GlyphSource->Delete();
+    this->GlyphSource = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMGlyph3DRepresentationProxy::BeginCreateVTKObjects()
+{
+  if (!this->Superclass::BeginCreateVTKObjects())
+    {
+    return false;
+    }
+
+  // The glyph filter only computes the per-point transforms...
+  vtkSMPropertyHelper(this->GeometryFilter, "GenerateInstances").Set(1);
+
+  // ... which the mapper applies to the glyph source at draw time:
+  // GlyphMode = UseGlyph | ScaledGlyph | OrientedGlyph, scaling by the three
+  // components of the scale array (Xc0_Xc1_Xc2, SCALE_BY_COMPONENTS) and
+  // orienting along the direction array (DIRECTION).
+  vtkSMPropertyHelper(this->Mapper, "ThreeDMode").Set(1);
+  vtkSMPropertyHelper(this->Mapper, "GlyphMode").Set(11);
+  vtkSMPropertyHelper(this->Mapper, "ScalingArrayMode").Set(1);
+  vtkSMPropertyHelper(this->Mapper, "ScaleMode").Set(1);
+  vtkSMPropertyHelper(this->Mapper, "GlyphXScalingArray").Set(
+    "point,GlyphInstanceScale,0");
+  vtkSMPropertyHelper(this->Mapper, "OrientationMode").Set(0);
+  vtkSMPropertyHelper(this->Mapper, "GlyphXOrientationArray").Set(
+    "point,GlyphInstanceOrientation,0");
+  vtkSMPropertyHelper(this->Mapper, "GlyphYOrientationArray").Set(
+    "point,GlyphInstanceOrientation,1");
+  vtkSMPropertyHelper(this->Mapper, "GlyphZOrientationArray").Set(
+    "point,GlyphInstanceOrientation,2");
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMGlyph3DRepresentationProxy::EndCreateVTKObjects()
+{
+  this->UpdateGlyphSource();
+  if (!this->GlyphSource)
+    {
+    return false;
+    }
+  return this->Superclass::EndCreateVTKObjects();
+}
+
+//----------------------------------------------------------------------------
+void vtkSMGlyph3DRepresentationProxy::SetGlyphType(int type)
+{
+  if (type < vtkSMGlyph3DRepresentationProxy::ARROW ||
+    type > vtkSMGlyph3DRepresentationProxy::GLYPH_2D)
+    {
+    vtkErrorMacro("Invalid glyph type: " << type);
+    return;
+    }
+  if (this->GlyphType == type)
+    {
+    return;
+    }
+  this->GlyphType = type;
+  this->Modified();
+  if (this->ObjectsCreated)
+    {
+    this->UpdateGlyphSource();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMGlyph3DRepresentationProxy::UpdateGlyphSource()
+{
+  static const char* const sourceNames[] =
+    {
+    "ArrowSource",
+    "ConeSource",
+    "CubeSource",
+    "CylinderSource",
+    "LineSource",
+    "SphereSource",
+    "GlyphSource2D"
+    };
+
+  vtkSMProxyManager* pxm = vtkSMProxyManager::GetProxyManager();
+  vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(
+    pxm->NewProxy("sources", sourceNames[this->GlyphType]));
+  if (!source)
+    {
+    vtkErrorMacro("Failed to create glyph source "
+      << sourceNames[this->GlyphType]);
+    return;
+    }
+  source->SetConnectionID(this->ConnectionID);
+
+  // The glyph geometry is only needed where the instances are drawn.
+  source->SetServers(
+    vtkProcessModule::CLIENT | vtkProcessModule::RENDER_SERVER);
+  source->UpdateVTKObjects();
+
+  this->Connect(source, this->Mapper, "GlyphInput");
+  if (this->GlyphSource)
+    {
+    this->GlyphSource->Delete();
+    }
+  this->GlyphSource = source;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMGlyph3DRepresentationProxy::SetColorArrayName(const char* name)
+{
+  // vtkPVGlyphFilter only passes point data through in instancing mode, so
+  // the coloring array is always looked up among the point arrays.
+  vtkSMIntVectorProperty* ivp = vtkSMIntVectorProperty::SafeDownCast(
+    this->Mapper->GetProperty("Colorize"));
+  vtkSMStringVectorProperty* svp = vtkSMStringVectorProperty::SafeDownCast(
+    this->Mapper->GetProperty("ColorizeArray"));
+  if (name && name[0])
+    {
+    vtkstd::string array = "point,";
+    array += name;
+    ivp->SetElement(0, 1);
+    svp->SetElement(0, array.c_str());
+    }
+  else
+    {
+    ivp->SetElement(0, 0);
+    svp->SetElement(0, "");
+    }
+
+  this->Superclass::SetColorArrayName(name);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMGlyph3DRepresentationProxy::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "GlyphType: " << this->GlyphType << endl;
+}
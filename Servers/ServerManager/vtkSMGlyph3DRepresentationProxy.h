@@ -0,0 +1,96 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    $RCSfile$
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMGlyph3DRepresentationProxy - representation that renders glyphs
+// by instancing a glyph source at draw time.
+// .SECTION Description
+// vtkSMGlyph3DRepresentationProxy is a surface representation whose geometry
+// filter is a vtkPVGlyphFilter in GenerateInstances mode. Only the glyphed
+// points together with their scale, orientation and coloring arrays are
+// delivered to the rendering processes, where a vtkScatterPlotMapper draws
+// the glyph source selected by GlyphType once per point. Compared to
+// showing the output of the Glyph filter, this avoids generating, moving and
+// compositing a full copy of the glyph geometry for every point.
+// .SECTION See Also
+// vtkPVGlyphFilter vtkScatterPlotMapper
+
+#ifndef __vtkSMGlyph3DRepresentationProxy_h
+#define __vtkSMGlyph3DRepresentationProxy_h
+
+#include "vtkSMSurfaceRepresentationProxy.h"
+
+class VTK_EXPORT vtkSMGlyph3DRepresentationProxy : 
+  public vtkSMSurfaceRepresentationProxy
+{
+public:
+  static vtkSMGlyph3DRepresentationProxy* New();
+  vtkTypeRevisionMacro(vtkSMGlyph3DRepresentationProxy,
+    vtkSMSurfaceRepresentationProxy);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the scalar color array name. If array name is 0 or "" then scalar
+  // coloring is disabled. Overridden to pass the array to the glyph mapper,
+  // which colors each glyph instance by the value at its point.
+  virtual void SetColorArrayName(const char* name);
+
+  // Description:
+  // Set the glyph drawn at every point. The choices are the same as the
+  // "Glyph Type" of the Glyph filter: ARROW (the default), CONE, CUBE,
+  // CYLINDER, LINE, SPHERE and GLYPH_2D.
+  void SetGlyphType(int type);
+  vtkGetMacro(GlyphType, int);
+
+//BTX
+  enum GlyphTypes
+    {
+    ARROW = 0,
+    CONE,
+    CUBE,
+    CYLINDER,
+    LINE,
+    SPHERE,
+    GLYPH_2D
+    };
+
+protected:
+  vtkSMGlyph3DRepresentationProxy();
+  ~vtkSMGlyph3DRepresentationProxy();
+
+  // Description:
+  // This method is called at the beginning of CreateVTKObjects().
+  // Overridden to create the glyph source on the rendering processes.
+  virtual bool BeginCreateVTKObjects();
+
+  // Description:
+  // This method is called after CreateVTKObjects(). 
+  // Overridden to connect the glyph source to the mapper.
+  virtual bool EndCreateVTKObjects();
+
+  // Description:
+  // Creates the source for the current GlyphType on the rendering processes
+  // and connects it to the mapper.
+  void UpdateGlyphSource();
+
+  int GlyphType;
+  vtkSMSourceProxy* GlyphSource;
+
+private:
+  vtkSMGlyph3DRepresentationProxy(const vtkSMGlyph3DRepresentationProxy&); // Not implemented
+  void operator=(const vtkSMGlyph3DRepresentationProxy&); // Not implemented
+//ETX
+};
+
+#endif
+
@@ -580,6 +580,17 @@ vtkSMProxy* vtkSMPVRepresentationProxy::GetProcessedConsumer()
   return this->Superclass::GetProcessedConsumer();
 }
 
+//----------------------------------------------------------------------------
+vtkSMProxy* vtkSMPVRepresentationProxy::GetProcessedProp3D()
+{
+  if (this->ActiveRepresentation)
+    {
+    return this->ActiveRepresentation->GetProcessedProp3D();
+    }
+
+  return this->Superclass::GetProcessedProp3D();
+}
+
 //----------------------------------------------------------------------------
 bool vtkSMPVRepresentationProxy::HasVisibleProp3D(vtkProp3D* prop)
 {
@@ -130,6 +130,7 @@ public:
   // to strategies (eg. in case of SurfaceRepresentation, it is the geometry
   // filter).
   virtual vtkSMProxy* GetProcessedConsumer();
+  virtual vtkSMProxy* GetProcessedProp3D();
 
   // Description:
   // Check if this representation has the prop by checking its vtkClientServerID
@@ -53,6 +53,7 @@ void vtkSMProxyDefinitionIterator::Begin()
     return;
     }
 
+  pm->LoadPendingConfigurations(0);
   this->Internals->GroupIterator = pm->Internals->GroupMap.begin();
   if (this->Internals->GroupIterator != pm->Internals->GroupMap.end())
     {
@@ -76,6 +77,7 @@ void vtkSMProxyDefinitionIterator::Begin(const char* groupName)
     return;
     }
 
+  pm->LoadPendingConfigurations(groupName);
   this->Internals->GroupIterator = pm->Internals->GroupMap.find(groupName);
   if (this->Internals->GroupIterator != pm->Internals->GroupMap.end())
     {
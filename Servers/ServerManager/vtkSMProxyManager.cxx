@@ -41,6 +41,7 @@
 #include "vtkStdString.h"
 #include "vtkStringList.h"
 
+#include <ctype.h>
 #include <vtkstd/map>
 #include <vtkstd/set>
 #include <vtkstd/vector>
@@ -108,8 +109,15 @@ vtkSMProxyManager::vtkSMProxyManager()
 {
   this->UpdateInputProxies = 0;
   this->Internals = new vtkSMProxyManagerInternals;
+  this->Internals->LoadingPendingConfigurations = false;
   this->Observer = vtkSMProxyManagerObserver::New();
   this->Observer->SetTarget(this);
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  if (pm)
+    {
+    pm->AddObserver(vtkProcessModule::ExecutionAbortedEvent, this->Observer);
+    this->Internals->ObservedProcessModule = pm;
+    }
 #if 0 // for debugging
   vtkSMProxyRegObserver* obs = new vtkSMProxyRegObserver;
   this->AddObserver(vtkCommand::RegisterEvent, obs);
@@ -124,6 +132,10 @@ vtkSMProxyManager::vtkSMProxyManager()
 vtkSMProxyManager::~vtkSMProxyManager()
 {
   this->UnRegisterProxies();
+  if (this->Internals->ObservedProcessModule.GetPointer())
+    {
+    this->Internals->ObservedProcessModule->RemoveObserver(this->Observer);
+    }
   delete this->Internals;
 
   this->Observer->SetTarget(0);
@@ -170,6 +182,7 @@ void vtkSMProxyManager::InstantiateGroupPrototypes(const char* groupName)
 
   vtksys_ios::ostringstream newgroupname;
   newgroupname << groupName << "_prototypes" << ends;
+  this->LoadPendingConfigurations(groupName);
   // Find the XML elements from which the proxies can be instantiated and
   // initialized
   vtkSMProxyManagerInternals::GroupMapType::iterator it =
@@ -201,6 +214,7 @@ void vtkSMProxyManager::InstantiateGroupPrototypes(const char* groupName)
 //----------------------------------------------------------------------------
 void vtkSMProxyManager::InstantiatePrototypes()
 {
+  this->LoadPendingConfigurations(0);
   vtkSMProxyManagerInternals::GroupMapType::iterator it = 
     this->Internals->GroupMap.begin();
   for (; it != this->Internals->GroupMap.end(); ++it)
@@ -214,6 +228,10 @@ void vtkSMProxyManager::AddElement(const char* groupName,
                                    const char* name,
                                    vtkPVXMLElement* element)
 {
+  // Definitions registered earlier for this group must be in place first,
+  // so that they are overridden or extended as if they had been parsed.
+  this->LoadPendingConfigurations(groupName);
+
   vtkSMProxyManagerElementMapType& elementMap = 
     this->Internals->GroupMap[groupName];
 
@@ -334,6 +352,8 @@ int vtkSMProxyManager::ProxyElementExists(const char* groupName,
     {
     return 0;
     }
+  this->LoadPendingConfigurations(groupName);
+
   // Find the XML element from the proxy.
   // 
   vtkSMProxyManagerInternals::GroupMapType::iterator it =
@@ -359,6 +379,7 @@ int vtkSMProxyManager::ProxyElementExists(const char* groupName,
 vtkPVXMLElement* vtkSMProxyManager::GetProxyElement(const char* groupName, 
                                                     const char* proxyName)
 {
+  this->LoadPendingConfigurations(groupName);
   vtkPVXMLElement* element = this->Internals->GetProxyElement(groupName, proxyName);
   if (element)
     {
@@ -373,12 +394,14 @@ vtkPVXMLElement* vtkSMProxyManager::GetProxyElement(const char* groupName,
 //---------------------------------------------------------------------------
 unsigned int vtkSMProxyManager::GetNumberOfXMLGroups()
 {
+  this->LoadPendingConfigurations(0);
   return this->Internals->GroupMap.size();
 }
 
 //---------------------------------------------------------------------------
 const char* vtkSMProxyManager::GetXMLGroupName(unsigned int n)
 {
+  this->LoadPendingConfigurations(0);
   unsigned int idx;
   vtkSMProxyManagerInternals::GroupMapType::iterator it = 
     this->Internals->GroupMap.begin();
@@ -399,6 +422,7 @@ const char* vtkSMProxyManager::GetXMLGroupName(unsigned int n)
 //---------------------------------------------------------------------------
 unsigned int vtkSMProxyManager::GetNumberOfXMLProxies(const char* groupName)
 {
+  this->LoadPendingConfigurations(groupName);
   vtkSMProxyManagerInternals::GroupMapType::iterator it =
     this->Internals->GroupMap.find(groupName);
   if (it != this->Internals->GroupMap.end())
@@ -413,6 +437,7 @@ unsigned int vtkSMProxyManager::GetNumberOfXMLProxies(const char* groupName)
 const char* vtkSMProxyManager::GetXMLProxyName(const char* groupName, 
   unsigned int n)
 {
+  this->LoadPendingConfigurations(groupName);
   vtkSMProxyManagerInternals::GroupMapType::iterator it =
     this->Internals->GroupMap.find(groupName);
   if (it != this->Internals->GroupMap.end())
@@ -467,6 +492,7 @@ vtkSMProxy* vtkSMProxyManager::GetPrototypeProxy(const char* groupname,
     return proxy;
     }
 
+  this->LoadPendingConfigurations(groupname);
   if (!this->Internals->GetProxyElement(groupname, name))
     {
     // No definition was located for the requested proxy.
@@ -1071,6 +1097,13 @@ void vtkSMProxyManager::UnRegisterAllLinks()
 void vtkSMProxyManager::ExecuteEvent(vtkObject* obj, unsigned long event,
   void* data)
 {
+  if (event == vtkProcessModule::ExecutionAbortedEvent &&
+    obj == vtkProcessModule::GetProcessModule())
+    {
+    this->MarkAbortedProxiesDirty();
+    return;
+    }
+
   vtkSMProxy* proxy = vtkSMProxy::SafeDownCast(obj);
   if (!proxy)
     {
@@ -1106,6 +1139,83 @@ void vtkSMProxyManager::ExecuteEvent(vtkObject* obj, unsigned long event,
     }
 }
 
+//---------------------------------------------------------------------------
+bool vtkSMProxyManager::FindAbortedObjects(vtkSMProxy* proxy)
+{
+  // The ids found are removed from the set.
+  bool found = false;
+  if (proxy->ObjectsCreated &&
+    this->Internals->AbortedObjectIDs.erase(proxy->VTKObjectID) > 0)
+    {
+    found = true;
+    }
+  unsigned int numSubProxies = proxy->GetNumberOfSubProxies();
+  for (unsigned int cc=0; cc < numSubProxies; cc++)
+    {
+    if (this->FindAbortedObjects(proxy->GetSubProxy(cc)))
+      {
+      found = true;
+      }
+    }
+  return found;
+}
+
+//---------------------------------------------------------------------------
+void vtkSMProxyManager::MarkAbortedProxiesDirty()
+{
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkstd::set<vtkClientServerID>& aborted = this->Internals->AbortedObjectIDs;
+  aborted.clear();
+  int numAborted = pm->GetNumberOfAbortedObjects();
+  for (int cc=0; cc < numAborted; cc++)
+    {
+    aborted.insert(pm->GetAbortedObjectID(cc));
+    }
+
+  vtkstd::vector<vtkSmartPointer<vtkSMProxy> > dirtyProxies;
+  vtkstd::vector<vtkSmartPointer<vtkSMProxy> > representations;
+  vtkSMProxyManagerInternals::ProxyGroupType::iterator it =
+    this->Internals->RegisteredProxyMap.begin();
+  for (; it != this->Internals->RegisteredProxyMap.end(); it++)
+    {
+    vtkSMProxyManagerProxyMapType::iterator it2 = it->second.begin();
+    for (; it2 != it->second.end(); it2++)
+      {
+      vtkSMProxyManagerProxyListType::iterator it3 = it2->second.begin();
+      for (; it3 != it2->second.end(); it3++)
+        {
+        vtkSMProxy* proxy = it3->GetPointer()->Proxy;
+        if (this->FindAbortedObjects(proxy))
+          {
+          dirtyProxies.push_back(proxy);
+          }
+        if (proxy->IsA("vtkSMRepresentationProxy"))
+          {
+          representations.push_back(proxy);
+          }
+        }
+      }
+    }
+
+  // The remaining objects belong to proxies that are neither registered
+  // nor subproxies, such as representation strategies. Update all
+  // representations again, to be safe.
+  if (!aborted.empty())
+    {
+    dirtyProxies.insert(dirtyProxies.end(), representations.begin(),
+      representations.end());
+    aborted.clear();
+    }
+
+  // Passing no modified proxy makes representations mark their strategies
+  // dirty as well. Consumers are marked dirty by MarkDirty() itself.
+  vtkstd::vector<vtkSmartPointer<vtkSMProxy> >::iterator iter;
+  for (iter = dirtyProxies.begin(); iter != dirtyProxies.end(); ++iter)
+    {
+    iter->GetPointer()->MarkDirty(0);
+    }
+}
+
 //---------------------------------------------------------------------------
 void vtkSMProxyManager::MarkProxyAsModified(vtkSMProxy* proxy)
 {
@@ -1475,6 +1585,7 @@ void vtkSMProxyManager::UnRegisterCustomProxyDefinitions()
 void vtkSMProxyManager::UnRegisterCustomProxyDefinition(
   const char* group, const char* name)
 {
+  this->LoadPendingConfigurations(group);
   vtkSMProxyManagerElementMapType& elementMap = 
     this->Internals->GroupMap[group];
   vtkSMProxyManagerElementMapType::iterator iter = elementMap.find(name) ;
@@ -1505,7 +1616,7 @@ void vtkSMProxyManager::RegisterCustomProxyDefinition(
     return;
     }
 
-
+  this->LoadPendingConfigurations(group);
   vtkSMProxyManagerElementMapType& elementMap = 
     this->Internals->GroupMap[group];
   vtkSMProxyManagerElementMapType::iterator iter = elementMap.find(name);
@@ -1545,6 +1656,7 @@ vtkPVXMLElement* vtkSMProxyManager::GetProxyDefinition(
     return 0;
     }
 
+  this->LoadPendingConfigurations(group);
   return this->Internals->GetProxyElement(group, name);
 }
 
@@ -1847,6 +1959,224 @@ bool vtkSMProxyManager::LoadConfigurationXML(const char* xml)
   return false;
 }
 
+//---------------------------------------------------------------------------
+// Extracts the value of the name attribute from the start tag [tag, end).
+static bool vtkSMProxyManagerGetNameAttribute(
+  const char* tag, const char* end, vtkstd::string& name)
+{
+  const char* p = tag + 1;
+  while (p < end && !isspace(*p) && *p != '/')
+    {
+    ++p;
+    }
+  while (p < end)
+    {
+    while (p < end && (isspace(*p) || *p == '/'))
+      {
+      ++p;
+      }
+    const char* attrStart = p;
+    while (p < end && *p != '=' && !isspace(*p))
+      {
+      ++p;
+      }
+    const char* attrEnd = p;
+    while (p < end && isspace(*p))
+      {
+      ++p;
+      }
+    if (p >= end || *p != '=')
+      {
+      return false;
+      }
+    ++p;
+    while (p < end && isspace(*p))
+      {
+      ++p;
+      }
+    if (p >= end || (*p != '"' && *p != '\''))
+      {
+      return false;
+      }
+    char quote = *p;
+    const char* valueStart = ++p;
+    while (p < end && *p != quote)
+      {
+      ++p;
+      }
+    if (p >= end)
+      {
+      return false;
+      }
+    if (attrEnd - attrStart == 4 && strncmp(attrStart, "name", 4) == 0)
+      {
+      name.assign(valueStart, p - valueStart);
+      // Leave values with entity references to the real parser.
+      return name.find('&') == vtkstd::string::npos;
+      }
+    ++p;
+    }
+  return false;
+}
+
+//---------------------------------------------------------------------------
+// Finds the names of the groups, i.e. the children of the root element, of
+// a configuration without building the element tree. Returns false if the
+// xml has anything this simple scan does not handle.
+static bool vtkSMProxyManagerScanGroups(
+  const char* xml, vtkstd::set<vtkstd::string>& groups)
+{
+  int depth = 0;
+  bool hasRoot = false;
+  const char* p = strchr(xml, '<');
+  while (p)
+    {
+    if (strncmp(p, "<!--", 4) == 0)
+      {
+      p = strstr(p + 4, "-->");
+      }
+    else if (strncmp(p, "<![CDATA[", 9) == 0)
+      {
+      p = strstr(p + 9, "]]>");
+      }
+    else if (p[1] == '?')
+      {
+      p = strstr(p + 2, "?>");
+      }
+    else if (p[1] == '!')
+      {
+      // DOCTYPE, without internal subset.
+      const char* end = strchr(p, '>');
+      const char* subset = strchr(p, '[');
+      p = (subset && subset < end)? 0 : end;
+      }
+    else if (p[1] == '/')
+      {
+      if (--depth < 0)
+        {
+        return false;
+        }
+      p = strchr(p, '>');
+      }
+    else
+      {
+      const char* tag = p;
+      char quote = 0;
+      for (++p; *p && (quote || *p != '>'); ++p)
+        {
+        if (quote)
+          {
+          quote = (*p == quote)? 0 : quote;
+          }
+        else if (*p == '"' || *p == '\'')
+          {
+          quote = *p;
+          }
+        }
+      if (!*p)
+        {
+        return false;
+        }
+      bool empty = (p[-1] == '/');
+      if (depth == 0)
+        {
+        if (hasRoot)
+          {
+          return false;
+          }
+        hasRoot = true;
+        }
+      else if (depth == 1)
+        {
+        vtkstd::string name;
+        if (!vtkSMProxyManagerGetNameAttribute(tag, p, name))
+          {
+          return false;
+          }
+        groups.insert(name);
+        }
+      if (!empty)
+        {
+        depth++;
+        }
+      }
+    if (!p)
+      {
+      return false;
+      }
+    p = strchr(p, '<');
+    }
+  return hasRoot && depth == 0;
+}
+
+//---------------------------------------------------------------------------
+bool vtkSMProxyManager::RegisterConfigurationXML(const char* xml)
+{
+  if (!xml)
+    {
+    return false;
+    }
+
+  vtkSMProxyManagerInternals::PendingConfiguration configuration;
+  if (!vtkSMProxyManagerScanGroups(xml, configuration.Groups) ||
+    configuration.Groups.empty())
+    {
+    return this->LoadConfigurationXML(xml);
+    }
+  configuration.XML = xml;
+  this->Internals->PendingConfigurations.push_back(configuration);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+void vtkSMProxyManager::LoadPendingConfigurations(const char* groupName)
+{
+  typedef vtkSMProxyManagerInternals::PendingConfigurationsType
+    PendingConfigurationsType;
+  PendingConfigurationsType& pending = this->Internals->PendingConfigurations;
+  if (pending.empty() || this->Internals->LoadingPendingConfigurations)
+    {
+    return;
+    }
+
+  // A configuration defining the group can only be parsed after the ones
+  // registered before it that define any group in common, so that
+  // definitions override and extend each other in registration order.
+  // Walk backwards collecting those.
+  PendingConfigurationsType toLoad;
+  vtkstd::set<vtkstd::string> groups;
+  if (groupName)
+    {
+    groups.insert(groupName);
+    }
+  PendingConfigurationsType::iterator iter = pending.end();
+  while (iter != pending.begin())
+    {
+    --iter;
+    bool needed = (groupName == 0);
+    vtkstd::set<vtkstd::string>::const_iterator git = iter->Groups.begin();
+    for (; !needed && git != iter->Groups.end(); ++git)
+      {
+      needed = (groups.find(*git) != groups.end());
+      }
+    if (needed)
+      {
+      groups.insert(iter->Groups.begin(), iter->Groups.end());
+      PendingConfigurationsType::iterator next = iter;
+      ++next;
+      toLoad.splice(toLoad.begin(), pending, iter);
+      iter = next;
+      }
+    }
+
+  this->Internals->LoadingPendingConfigurations = true;
+  for (iter = toLoad.begin(); iter != toLoad.end(); ++iter)
+    {
+    this->LoadConfigurationXML(iter->XML.c_str());
+    }
+  this->Internals->LoadingPendingConfigurations = false;
+}
+
 //---------------------------------------------------------------------------
 void vtkSMProxyManager::PrintSelf(ostream& os, vtkIndent indent)
 {
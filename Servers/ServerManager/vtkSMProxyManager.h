@@ -479,6 +479,16 @@ public:
   // Loads server-manager configuration xml.
   bool LoadConfigurationXML(const char* xmlcontents);
 
+  // Description:
+  // Registers server-manager configuration xml without parsing it. Only the
+  // names of the groups it defines are extracted. The xml is parsed the
+  // first time a definition from one of these groups is requested (or all
+  // groups are enumerated), so that definitions that are never used are not
+  // parsed at all. If the group names cannot be extracted, the xml is loaded
+  // right away as with LoadConfigurationXML(). Returns false if the xml
+  // could not be parsed.
+  bool RegisterConfigurationXML(const char* xmlcontents);
+
 //BTX
 protected:
   vtkSMProxyManager();
@@ -490,6 +500,11 @@ protected:
   void AddElement(
     const char* groupName, const char* name, vtkPVXMLElement* element);
 
+  // Description:
+  // Parses the configuration xml registered with RegisterConfigurationXML()
+  // that defines the given group, or all of it when groupName is NULL.
+  void LoadPendingConfigurations(const char* groupName);
+
   friend class vtkSMGlobalPropertiesManager;
   friend class vtkSMProxy;
   friend class vtkSMProxyDefinitionIterator;
@@ -518,6 +533,17 @@ protected:
   void MarkProxyAsModified(vtkSMProxy*);
   void UnMarkProxyAsModified(vtkSMProxy*);
 
+  // Description:
+  // Called when the process module reports an aborted execution. Marks
+  // the registered proxies whose VTK objects were aborted dirty so that
+  // they are updated again.
+  void MarkAbortedProxiesDirty();
+
+  // Description:
+  // Returns true if the VTK object of the proxy, or of one of its
+  // subproxies, was aborted. Used by MarkAbortedProxiesDirty().
+  bool FindAbortedObjects(vtkSMProxy* proxy);
+
   // Description:
   // Save/Load registered link states.
   void SaveRegisteredLinks(vtkPVXMLElement* root);
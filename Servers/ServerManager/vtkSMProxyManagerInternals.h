@@ -22,7 +22,9 @@
 #include "vtkSMLink.h"
 #include "vtkSMProxy.h"
 #include "vtkSMProxySelectionModel.h"
+#include "vtkWeakPointer.h"
 
+#include <vtkstd/list>
 #include <vtkstd/map>
 #include <vtkstd/set>
 #include <vtkstd/vector>
@@ -189,6 +191,19 @@ struct vtkSMProxyManagerInternals
   vtkstd::map<vtkStdString, vtkSMProxyManagerElementMapType> GroupMapType;
   GroupMapType GroupMap;
 
+  // Configuration xml registered with RegisterConfigurationXML() that has
+  // not been parsed yet, with the names of the groups it defines. It is
+  // parsed the first time one of these groups is accessed.
+  struct PendingConfiguration
+    {
+    vtkstd::string XML;
+    vtkstd::set<vtkstd::string> Groups;
+    };
+  typedef vtkstd::list<PendingConfiguration> PendingConfigurationsType;
+  PendingConfigurationsType PendingConfigurations;
+  // Set while pending configurations are parsed.
+  bool LoadingPendingConfigurations;
+
   // This data structure stores actual proxy instances grouped in
   // collections.
   typedef 
@@ -199,6 +214,14 @@ struct vtkSMProxyManagerInternals
   typedef vtkstd::set<vtkSMProxy*> SetOfProxies;
   SetOfProxies ModifiedProxies;
 
+  // Ids of the aborted VTK objects not yet matched to a proxy. Only used
+  // while marking aborted proxies dirty.
+  vtkstd::set<vtkClientServerID> AbortedObjectIDs;
+
+  // The process module observed for aborted executions. It may be deleted
+  // before the proxy manager.
+  vtkWeakPointer<vtkObject> ObservedProcessModule;
+
   // Data structure to save registered links.
   typedef vtkstd::map<vtkStdString, vtkSmartPointer<vtkSMLink> >
     LinkType;
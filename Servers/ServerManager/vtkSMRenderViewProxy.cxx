@@ -42,6 +42,7 @@
 #include "vtkPVOpenGLExtensionsInformation.h"
 #include "vtkPVOptions.h"
 #include "vtkPVServerInformation.h"
+#include "vtkPVSelectionInformation.h"
 #include "vtkPVXMLElement.h"
 #include "vtkRendererCollection.h"
 #include "vtkRenderer.h"
@@ -130,6 +131,8 @@ vtkSMRenderViewProxy::vtkSMRenderViewProxy()
   this->ResetPolygonsPerSecondResults();
   this->MeasurePolygonsPerSecond = 0;
   this->UseOffscreenRenderingForScreenshots = 0;
+  this->UseSpatialIndexSelection = 0;
+  this->LocatorSelector = 0;
 
   this->LODThreshold = 0.0;
 
@@ -165,6 +168,11 @@ vtkSMRenderViewProxy::~vtkSMRenderViewProxy()
   this->ActiveCamera = 0;
   this->RenderTimer->Delete();
   this->RenderTimer = 0;
+  if (this->LocatorSelector)
+    {
+    this->LocatorSelector->Delete();
+    this->LocatorSelector = 0;
+    }
   if (this->OpenGLExtensionsInformation)
     {
     this->OpenGLExtensionsInformation->Delete();
@@ -1281,6 +1289,12 @@ bool vtkSMRenderViewProxy::IsSelectionAvailable()
 //-----------------------------------------------------------------------------
 const char* vtkSMRenderViewProxy::IsSelectVisibleCellsAvailable()
 { 
+  if (this->UseSpatialIndexSelection)
+    {
+    // Nothing is rendered.
+    return NULL;
+    }
+
   //check if we don't have enough color depth to do color buffer selection
   //if we don't then disallow selection
   int rgba[4];
@@ -1436,6 +1450,29 @@ bool vtkSMRenderViewProxy::SelectOnSurface(unsigned int x0,
 }
 
 
+//-----------------------------------------------------------------------------
+void vtkSMRenderViewProxy::ComputeFrustumCorners(int displayRectangle[4],
+  double worldP[32])
+{
+  //convert screen rectangle to world frustum
+  vtkRenderer *renderer = this->GetRenderer();
+  int index=0;
+  for (int x=0; x < 2; x++)
+    {
+    for (int y=0; y < 2; y++)
+      {
+      for (int z=0; z < 2; z++)
+        {
+        renderer->SetDisplayPoint(displayRectangle[x==0? 0 : 2],
+          displayRectangle[y==0? 1 : 3], z);
+        renderer->DisplayToWorld();
+        renderer->GetWorldPoint(&worldP[index*4]);
+        index++;
+        }
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
 bool vtkSMRenderViewProxy::SelectFrustum(unsigned int x0, 
                                          unsigned int y0, unsigned int x1, unsigned int y1,
@@ -1456,60 +1493,15 @@ bool vtkSMRenderViewProxy::SelectFrustum(unsigned int x0,
     }
 
   // 1) Create frustum selection 
+  double worldP[32]; 
+  this->ComputeFrustumCorners(displayRectangle, worldP);
   vtkDoubleArray *frustcorners = vtkDoubleArray::New();
   frustcorners->SetNumberOfComponents(4);
   frustcorners->SetNumberOfTuples(8);
-  //convert screen rectangle to world frustum
-  vtkRenderer *renderer = this->GetRenderer();
-  double worldP[32]; 
-  int index=0;
-  renderer->SetDisplayPoint(displayRectangle[0], displayRectangle[1], 0);
-  renderer->DisplayToWorld();
-  renderer->GetWorldPoint(&worldP[index*4]);
-  frustcorners->SetTuple4(index,  worldP[index*4], worldP[index*4+1], 
-    worldP[index*4+2], worldP[index*4+3]);
-  index++;
-  renderer->SetDisplayPoint(displayRectangle[0], displayRectangle[1], 1);
-  renderer->DisplayToWorld();
-  renderer->GetWorldPoint(&worldP[index*4]);
-  frustcorners->SetTuple4(index,  worldP[index*4], worldP[index*4+1], 
-    worldP[index*4+2], worldP[index*4+3]);
-  index++;
-  renderer->SetDisplayPoint(displayRectangle[0], displayRectangle[3], 0);
-  renderer->DisplayToWorld();
-  renderer->GetWorldPoint(&worldP[index*4]);
-  frustcorners->SetTuple4(index,  worldP[index*4], worldP[index*4+1], 
-    worldP[index*4+2], worldP[index*4+3]);
-  index++;
-  renderer->SetDisplayPoint(displayRectangle[0], displayRectangle[3], 1);
-  renderer->DisplayToWorld();
-  renderer->GetWorldPoint(&worldP[index*4]);
-  frustcorners->SetTuple4(index,  worldP[index*4], worldP[index*4+1], 
-    worldP[index*4+2], worldP[index*4+3]);
-  index++;
-  renderer->SetDisplayPoint(displayRectangle[2], displayRectangle[1], 0);
-  renderer->DisplayToWorld();
-  renderer->GetWorldPoint(&worldP[index*4]);
-  frustcorners->SetTuple4(index,  worldP[index*4], worldP[index*4+1], 
-    worldP[index*4+2], worldP[index*4+3]);
-  index++;
-  renderer->SetDisplayPoint(displayRectangle[2], displayRectangle[1], 1);
-  renderer->DisplayToWorld();
-  renderer->GetWorldPoint(&worldP[index*4]);
-  frustcorners->SetTuple4(index,  worldP[index*4], worldP[index*4+1], 
-    worldP[index*4+2], worldP[index*4+3]);
-  index++;
-  renderer->SetDisplayPoint(displayRectangle[2], displayRectangle[3], 0);
-  renderer->DisplayToWorld();
-  renderer->GetWorldPoint(&worldP[index*4]);
-  frustcorners->SetTuple4(index,  worldP[index*4], worldP[index*4+1], 
-    worldP[index*4+2], worldP[index*4+3]);
-  index++;
-  renderer->SetDisplayPoint(displayRectangle[2], displayRectangle[3], 1);
-  renderer->DisplayToWorld();
-  renderer->GetWorldPoint(&worldP[index*4]);
-  frustcorners->SetTuple4(index,  worldP[index*4], worldP[index*4+1], 
-    worldP[index*4+2], worldP[index*4+3]);
+  for (int index=0; index < 8; index++)
+    {
+    frustcorners->SetTuple(index, &worldP[index*4]);
+    }
 
   vtkSelection* frustumSel = vtkSelection::New();
   vtkSelectionNode* frustumNode = vtkSelectionNode::New();
@@ -1610,6 +1602,11 @@ vtkSelection* vtkSMRenderViewProxy::SelectVisibleCells(unsigned int x0,
   y0 = (y0 >= wsy)? wsy-1: y0;
   y1 = (y1 >= wsy)? wsy-1: y1;
 
+  if (this->UseSpatialIndexSelection)
+    {
+    return this->SelectVisibleCellsUsingLocators(x0, y0, x1, y1, ofPoints);
+    }
+
   //Find number of rendering processors.
   int numProcessors = 1;
   vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
@@ -1742,6 +1739,113 @@ vtkSelection* vtkSMRenderViewProxy::SelectVisibleCells(unsigned int x0,
   return selection;
 }
 
+//-----------------------------------------------------------------------------
+vtkSelection* vtkSMRenderViewProxy::SelectVisibleCellsUsingLocators(
+  unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1,
+  int ofPoints)
+{
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  if (!this->LocatorSelector)
+    {
+    vtkSMProxyManager* proxyManager = vtkSMObject::GetProxyManager();
+    this->LocatorSelector = 
+      proxyManager->NewProxy("PropPickers", "LocatorSelector");
+    this->LocatorSelector->SetConnectionID(this->ConnectionID);
+    this->LocatorSelector->SetServers(vtkProcessModule::DATA_SERVER);
+    this->LocatorSelector->UpdateVTKObjects();
+    }
+
+  //If stripping is on, turn it off so that the cell ids on the surfaces
+  //match those of the original cells (see SelectVisibleCells()).
+  int use_strips = this->UseTriangleStrips;
+  if (use_strips)
+    {
+    this->ForceTriStripUpdate = 1;
+    this->SetUseTriangleStrips(0);    
+    this->ForceTriStripUpdate = 0;
+    }
+  // Bring the surfaces up to date without rendering.
+  this->UpdateAllRepresentations();
+
+  vtkClientServerStream stream;
+  stream << vtkClientServerStream::Invoke
+         << this->LocatorSelector->GetID()
+         << "RemoveAllSurfaces"
+         << vtkClientServerStream::End;
+
+  vtkSmartPointer<vtkCollectionIterator> iter;
+  iter.TakeReference(this->Representations->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+    vtkSMDataRepresentationProxy* repr = 
+      vtkSMDataRepresentationProxy::SafeDownCast(iter->GetCurrentObject());
+    if (!repr || !repr->GetVisibility())
+      {
+      continue;
+      }
+    if (repr->GetProperty("Pickable") &&
+      vtkSMPropertyHelper(repr, "Pickable").GetAsInt() == 0)
+      {
+      continue;
+      }
+    vtkSMProxy* surface = repr->GetProcessedConsumer();
+    vtkSMProxy* prop = repr->GetProcessedProp3D();
+    if (!surface || !prop)
+      {
+      continue;
+      }
+    stream << vtkClientServerStream::Invoke
+           << this->LocatorSelector->GetID()
+           << "AddSurface"
+           << surface->GetID()
+           << static_cast<int>(prop->GetID().ID)
+           << vtkClientServerStream::End;
+    }
+  pm->SendStream(this->ConnectionID, vtkProcessModule::DATA_SERVER, stream);
+
+  int displayRectangle[4] = {static_cast<int>(x0), static_cast<int>(y0),
+                             static_cast<int>(x1), static_cast<int>(y1)};
+  bool pickNearest = (x0 == x1 && y0 == y1);
+  if (displayRectangle[0] == displayRectangle[2])
+    {
+    displayRectangle[2] += 1;
+    }
+  if (displayRectangle[1] == displayRectangle[3])
+    {
+    displayRectangle[3] += 1;
+    }
+  double worldP[32];
+  this->ComputeFrustumCorners(displayRectangle, worldP);
+
+  vtkSMPropertyHelper(this->LocatorSelector, "Frustum").Set(worldP, 32);
+  vtkSMPropertyHelper(this->LocatorSelector, "FieldAssociation").Set(
+    ofPoints? 0 : 1);
+  vtkSMPropertyHelper(this->LocatorSelector, "PickNearest").Set(
+    pickNearest? 1 : 0);
+  this->LocatorSelector->UpdateVTKObjects();
+
+  stream << vtkClientServerStream::Invoke
+         << this->LocatorSelector->GetID()
+         << "Update"
+         << vtkClientServerStream::End;
+  pm->SendStream(this->ConnectionID, vtkProcessModule::DATA_SERVER, stream);
+
+  vtkPVSelectionInformation* selInfo = vtkPVSelectionInformation::New();
+  pm->GatherInformation(this->ConnectionID, vtkProcessModule::DATA_SERVER,
+    selInfo, this->LocatorSelector->GetID());
+
+  //Turn stripping back on if we had turned it off
+  if (use_strips)
+    {
+    this->SetUseTriangleStrips(1);
+    }
+
+  vtkSelection* selection = vtkSelection::New();
+  selection->ShallowCopy(selInfo->GetSelection());
+  selInfo->Delete();
+  return selection;
+}
+
 //-----------------------------------------------------------------------------
 vtkSMRepresentationProxy* vtkSMRenderViewProxy::CreateDefaultRepresentation(
   vtkSMProxy* source, int opport)
@@ -1895,6 +1999,8 @@ void vtkSMRenderViewProxy::PrintSelf(ostream& os, vtkIndent indent)
     << this->MeasurePolygonsPerSecond << endl;
   os << indent << "UseOffscreenRenderingForScreenshots: "
     << this->UseOffscreenRenderingForScreenshots << endl;
+  os << indent << "UseSpatialIndexSelection: "
+    << this->UseSpatialIndexSelection << endl;
   os << indent << "AveragePolygonsPerSecond: " 
     << this->AveragePolygonsPerSecond << endl;
   os << indent << "MaximumPolygonsPerSecond: " 
@@ -169,6 +169,16 @@ public:
   vtkSetClampMacro(MeasurePolygonsPerSecond, int, 0, 1);
   vtkBooleanMacro(MeasurePolygonsPerSecond, int);
   vtkGetMacro(MeasurePolygonsPerSecond, int);
+
+  // Description:
+  // When set, SelectVisibleCells() computes the selection on the data server
+  // using cell locators cached on the surfaces of the visible representations
+  // (see vtkPVLocatorSelector) instead of rendering ids into the frame buffer.
+  // A rectangle then selects all cells in the frustum, including occluded
+  // ones, while a single pixel selects the nearest cell. Off by default.
+  vtkSetClampMacro(UseSpatialIndexSelection, int, 0, 1);
+  vtkBooleanMacro(UseSpatialIndexSelection, int);
+  vtkGetMacro(UseSpatialIndexSelection, int);
   
   // Description:
   // Reset the tracking of polygons per second
@@ -319,6 +329,18 @@ protected:
   vtkSelection* NewSelectionForProp(vtkSelection* surfaceSelection, 
     vtkClientServerID propId);
 
+  // Description:
+  // Computes the world coordinates (x,y,z,w) of the 8 corners of the frustum
+  // through the display rectangle, in the order expected by
+  // vtkExtractSelectedFrustum::CreateFrustum().
+  void ComputeFrustumCorners(int displayRectangle[4], double worldP[32]);
+
+  // Description:
+  // SelectVisibleCells() implementation used when UseSpatialIndexSelection
+  // is set.
+  vtkSelection* SelectVisibleCellsUsingLocators(unsigned int x0,
+    unsigned int y0, unsigned int x1, unsigned int y1, int ofPoints);
+
   // Collection of props added to the renderer.
   vtkCollection* RendererProps; 
 
@@ -380,8 +402,12 @@ protected:
   vtkIdType AveragePolygonsPerSecondCount;
   int MeasurePolygonsPerSecond;
   int UseOffscreenRenderingForScreenshots;
+  int UseSpatialIndexSelection;
   bool LightKitAdded;
 
+  // Kept alive between selections so that the locators are reused.
+  vtkSMProxy* LocatorSelector;
+
   // Description:
   // Get the number of polygons this render module is rendering
   vtkIdType GetTotalNumberOfPolygons();
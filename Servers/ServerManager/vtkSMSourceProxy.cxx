@@ -200,6 +200,70 @@ void vtkSMSourceProxy::UpdatePipelineInformation()
   this->InvokeEvent(vtkCommand::UpdateInformationEvent);
   // this->MarkModified(this);  
 }
+//---------------------------------------------------------------------------
+void vtkSMSourceProxy::BulkUpdatePipelineInformation(vtkCollection* proxies)
+{
+  if (!proxies)
+    {
+    return;
+    }
+
+  vtkstd::vector<vtkSMSourceProxy*> sources;
+  vtkObject* obj;
+  for (proxies->InitTraversal(); (obj = proxies->GetNextItemAsObject()); )
+    {
+    vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(obj);
+    if (source)
+      {
+      sources.push_back(source);
+      }
+    }
+
+  // Collect the UpdateInformation() requests per destination.
+  vtkstd::vector<vtkIdType> connections;
+  vtkstd::vector<vtkTypeUInt32> servers;
+  vtkstd::vector<vtkClientServerStream> streams;
+  vtkstd::vector<vtkSMSourceProxy*>::iterator iter;
+  for (iter = sources.begin(); iter != sources.end(); ++iter)
+    {
+    vtkSMSourceProxy* source = *iter;
+    if (source->GetID().IsNull())
+      {
+      continue;
+      }
+    size_t cc;
+    for (cc = 0; cc < streams.size(); cc++)
+      {
+      if (connections[cc] == source->ConnectionID &&
+        servers[cc] == source->Servers)
+        {
+        break;
+        }
+      }
+    if (cc == streams.size())
+      {
+      connections.push_back(source->ConnectionID);
+      servers.push_back(source->Servers);
+      streams.push_back(vtkClientServerStream());
+      }
+    streams[cc] << vtkClientServerStream::Invoke
+      << source->GetID() << "UpdateInformation"
+      << vtkClientServerStream::End;
+    }
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  for (size_t cc = 0; cc < streams.size(); cc++)
+    {
+    pm->SendStream(connections[cc], servers[cc], streams[cc]);
+    }
+
+  for (iter = sources.begin(); iter != sources.end(); ++iter)
+    {
+    (*iter)->vtkSMProxy::UpdatePipelineInformation();
+    (*iter)->InvokeEvent(vtkCommand::UpdateInformationEvent);
+    }
+}
+
 //---------------------------------------------------------------------------
 int vtkSMSourceProxy::ReadXMLAttributes(vtkSMProxyManager* pm, 
                                         vtkPVXMLElement* element)
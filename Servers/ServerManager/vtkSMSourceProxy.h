@@ -33,6 +33,7 @@
 #include "vtkSMProxy.h"
 #include "vtkClientServerID.h" // Needed for ClientServerID
 
+class vtkCollection;
 class vtkPVArrayInformation;
 class vtkPVDataInformation;
 class vtkPVDataSetAttributesInformation;
@@ -53,6 +54,14 @@ public:
   // Calls UpdateInformation() on all sources.
   virtual void UpdatePipelineInformation();
 
+  // Description:
+  // Same as calling UpdatePipelineInformation() on each source proxy of the
+  // collection in turn, except that the UpdateInformation() requests are
+  // sent together, with one stream per connection and servers, before any
+  // information property is updated. The proxies should be ordered with
+  // inputs before the proxies consuming them.
+  static void BulkUpdatePipelineInformation(vtkCollection* proxies);
+
   // Description:
   // Calls Update() on all sources. It also creates output ports if
   // they are not already created.
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkSMStateLoader.h"
 
+#include "vtkCollection.h"
 #include "vtkObjectFactory.h"
 #include "vtkProcessModuleConnectionManager.h"
 #include "vtkPVXMLElement.h"
@@ -48,6 +49,12 @@ struct vtkSMStateLoaderInternals
   typedef vtkstd::vector<vtkSMStateLoaderRegistrationInfo> VectorOfRegInfo;
   typedef vtkstd::map<int, VectorOfRegInfo> RegInfoMapType;
   RegInfoMapType RegistrationInformation;
+
+  // Proxies created while loading the state, in the order they were created
+  // i.e. inputs before the proxies consuming them.
+  typedef vtkstd::vector<vtkstd::pair<int, vtkSmartPointer<vtkSMProxy> > >
+    CreatedProxiesType;
+  CreatedProxiesType CreatedProxies;
 };
 
 //---------------------------------------------------------------------------
@@ -152,11 +159,35 @@ void vtkSMStateLoader::CreatedNewProxy(int id, vtkSMProxy* proxy)
   // Ensure that the proxy is created before it is registered, unless we are
   // reviving the server-side server manager, which needs special handling.
   proxy->UpdateVTKObjects();
-  if (proxy->IsA("vtkSMSourceProxy"))
+
+  // Updating the pipeline information and registering the proxy are done
+  // once all proxies are created, see UpdateCreatedProxies().
+  this->Internal->CreatedProxies.push_back(
+    vtkSMStateLoaderInternals::CreatedProxiesType::value_type(id, proxy));
+}
+
+//---------------------------------------------------------------------------
+void vtkSMStateLoader::UpdateCreatedProxies()
+{
+  vtkSMStateLoaderInternals::CreatedProxiesType created;
+  created.swap(this->Internal->CreatedProxies);
+
+  vtkSmartPointer<vtkCollection> sources =
+    vtkSmartPointer<vtkCollection>::New();
+  vtkSMStateLoaderInternals::CreatedProxiesType::iterator iter;
+  for (iter = created.begin(); iter != created.end(); ++iter)
     {
-    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
+    if (iter->second->IsA("vtkSMSourceProxy"))
+      {
+      sources->AddItem(iter->second);
+      }
+    }
+  vtkSMSourceProxy::BulkUpdatePipelineInformation(sources);
+
+  for (iter = created.begin(); iter != created.end(); ++iter)
+    {
+    this->RegisterProxy(iter->first, iter->second);
     }
-  this->RegisterProxy(id, proxy);
 }
 
 //---------------------------------------------------------------------------
@@ -468,6 +499,8 @@ int vtkSMStateLoader::LoadState(vtkPVXMLElement* elem)
   this->ProxyLocator->SetDeserializer(this);
   int ret = this->LoadStateInternal(elem);
   this->ProxyLocator->SetDeserializer(0);
+  // Proxies created before the loading failed, if it did.
+  this->UpdateCreatedProxies();
   return ret;
 }
 
@@ -557,6 +590,8 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* rootElement)
       }
     }
 
+  this->UpdateCreatedProxies();
+
   // Clear internal data structures.
   this->Internal->RegistrationInformation.clear();
   this->ServerManagerStateElement = 0; 
@@ -65,6 +65,12 @@ protected:
   // We register all created proxies.
   virtual void CreatedNewProxy(int id, vtkSMProxy* proxy);
 
+  // Description:
+  // Updates the pipeline information of the proxies created since the last
+  // call, in creation order and with the requests to the servers batched,
+  // then registers them. Called once all proxies of the state are created.
+  virtual void UpdateCreatedProxies();
+
   // Description:
   // Overridden so that when new views are to be created, we create views
   // suitable for the connection. 
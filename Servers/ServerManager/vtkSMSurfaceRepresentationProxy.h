@@ -117,6 +117,11 @@ public:
   virtual vtkSMProxy* GetProcessedConsumer()
     { return (vtkSMProxy*)(this->GeometryFilter); }
 
+  // Description:
+  // Returns the prop rendering the geometry filter output.
+  virtual vtkSMProxy* GetProcessedProp3D()
+    { return this->Prop3D; }
+
   // Description:
   // Check if this representation has the prop by checking its vtkClientServerID
   virtual bool HasVisibleProp3D(vtkProp3D* prop);
@@ -19,12 +19,18 @@
 #include "vtkProcessModuleConnectionManager.h"
 #include "vtkProcessModule.h"
 #include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+#include "vtkSmartPointer.h"
 #include "vtkSMIdBasedProxyLocator.h"
 #include "vtkSMProxyManager.h"
 #include "vtkSMUndoRedoStateLoader.h"
 #include "vtkUndoSet.h"
 #include "vtkUndoStackInternal.h"
+#include "vtkZLibDataCompressor.h"
 
+#include <vtkstd/string>
+#include <vtkstd/vector>
+#include <vtksys/ios/sstream>
 #include <vtksys/RegularExpression.hxx>
 
 //*****************************************************************************
@@ -68,13 +74,8 @@ public:
   virtual int Undo() 
     {
     int status=0;
-    vtkPVXMLElement* state;
-    if (this->State)
-      {
-      state = this->State;
-      state->Register(this);
-      }
-    else
+    vtkPVXMLElement* state = this->NewState();
+    if (!state)
       {
       vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
       state = pm->NewNextUndo(this->ConnectionID);
@@ -90,13 +91,8 @@ public:
   virtual int Redo() 
     {
     int status = 0;
-    vtkPVXMLElement* state;
-    if (this->State)
-      {
-      state = this->State;
-      state->Register(this);
-      }
-    else
+    vtkPVXMLElement* state = this->NewState();
+    if (!state)
       {
       vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
       state = pm->NewNextRedo(this->ConnectionID);
@@ -112,13 +108,8 @@ public:
   //begin vistrails
   vtkUndoSet* getLastUndoSet()
   {
-    vtkPVXMLElement* state;
-    if (this->State)
-      {
-      state = this->State;
-      state->Register(this);
-      }
-    else
+    vtkPVXMLElement* state = this->NewState();
+    if (!state)
       {
       vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
       state = pm->NewNextUndo(this->ConnectionID);
@@ -163,9 +154,79 @@ public:
     this->UndoRedoManager = r;
     }
 
+  // The state is kept as compressed xml text, which takes a fraction of the
+  // memory of the element tree, particularly for properties with many
+  // values.
   void SetState(vtkPVXMLElement* elem)
     {
-    this->State = elem;
+    this->State.clear();
+    this->StateLength = 0;
+    if (!elem)
+      {
+      return;
+      }
+    vtksys_ios::ostringstream xml;
+    elem->PrintXML(xml, vtkIndent());
+    const vtkstd::string& text = xml.str();
+
+    vtkSmartPointer<vtkZLibDataCompressor> compressor =
+      vtkSmartPointer<vtkZLibDataCompressor>::New();
+    compressor->SetCompressionLevel(1);
+    vtkstd::vector<unsigned char> compressed(
+      compressor->GetMaximumCompressionSpace(text.size()));
+    unsigned long size = compressor->Compress(
+      reinterpret_cast<const unsigned char*>(text.c_str()), text.size(),
+      &compressed[0], compressed.size());
+    if (size == 0)
+      {
+      // Keep the text uncompressed.
+      this->State.assign(text.begin(), text.end());
+      return;
+      }
+    this->State.assign(compressed.begin(), compressed.begin() + size);
+    this->StateLength = text.size();
+    }
+
+  // Returns a new state element, or NULL if no state was set.
+  vtkPVXMLElement* NewState()
+    {
+    if (this->State.empty())
+      {
+      return NULL;
+      }
+    vtkstd::string text;
+    if (this->StateLength > 0)
+      {
+      text.resize(this->StateLength);
+      vtkSmartPointer<vtkZLibDataCompressor> compressor =
+        vtkSmartPointer<vtkZLibDataCompressor>::New();
+      if (compressor->Uncompress(&this->State[0], this->State.size(),
+          reinterpret_cast<unsigned char*>(&text[0]), text.size()) !=
+        text.size())
+        {
+        vtkErrorMacro("Failed to uncompress the undo/redo state.");
+        return NULL;
+        }
+      }
+    else
+      {
+      text.assign(this->State.begin(), this->State.end());
+      }
+    vtkSmartPointer<vtkPVXMLParser> parser =
+      vtkSmartPointer<vtkPVXMLParser>::New();
+    if (!parser->Parse(text.c_str()) || !parser->GetRootElement())
+      {
+      vtkErrorMacro("Failed to parse the undo/redo state.");
+      return NULL;
+      }
+    vtkPVXMLElement* state = parser->GetRootElement();
+    state->Register(this);
+    return state;
+    }
+
+  virtual unsigned long GetActualMemorySize()
+    {
+    return static_cast<unsigned long>(this->State.size() / 1024 + 1);
     }
 
 protected:
@@ -173,15 +234,19 @@ protected:
     {
     this->ConnectionID = vtkProcessModuleConnectionManager::GetNullConnectionID();
     this->UndoRedoManager = 0;
+    this->StateLength = 0;
     };
   ~vtkSMUndoStackUndoSet(){ };
 
   vtkIdType ConnectionID;
   vtkSMUndoStack* UndoRedoManager;
 
-  // State is set for Client side only elements. If state is NULL, then and then 
-  // alone an attempt is made to obtain the state from the server.
-  vtkSmartPointer<vtkPVXMLElement> State;
+  // State is set for Client side only elements. If state is empty, then and
+  // then alone an attempt is made to obtain the state from the server.
+  // StateLength is the size of the uncompressed text, 0 if the text could
+  // not be compressed.
+  vtkstd::vector<unsigned char> State;
+  size_t StateLength;
 private:
   vtkSMUndoStackUndoSet(const vtkSMUndoStackUndoSet&);
   void operator=(const vtkSMUndoStackUndoSet&);
@@ -199,6 +264,7 @@ vtkSMUndoStack::vtkSMUndoStack()
 {
   this->ClientOnly = 0;
   this->StateLoader = NULL;
+  this->MemoryLimit = 256*1024;
 
   this->Observer = vtkSMUndoStackObserver::New();
   this->Observer->SetTarget(this);
@@ -27,6 +27,9 @@
 // This class also provides API to push any vtkUndoSet instance on to a 
 // server. GUI can use this to push its own changes that is undoable across
 // connections.
+//
+// States kept on the client are stored as compressed XML text. The
+// MemoryLimit is set to 256 MiB by default.
 // 
 // .SECTION See Also
 // vtkSMUndoStackBuilder
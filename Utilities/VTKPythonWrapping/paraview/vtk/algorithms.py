@@ -40,10 +40,10 @@ def norm(a):
     return a/mag(a)
 
 def min(narray):
-    return numpy.min(numpy.array(narray))
+    return numpy.min(numpy.asarray(narray))
 
 def max(narray):
-    return numpy.max(numpy.array(narray))
+    return numpy.max(numpy.asarray(narray))
 
 def divergence(narray, dataset=None):
     if not dataset:
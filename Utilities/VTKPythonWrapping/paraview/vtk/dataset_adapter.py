@@ -50,18 +50,6 @@ def numpyTovtkDataArray(array, name="numpy_array"):
     vtkarray.AddObserver('DeleteEvent', MakeObserver(array))
     return vtkarray
 
-def make_tensor_array_contiguous(array):
-    if array == None:
-        return None
-    if array.flags.contiguous:
-        return array
-    array = numpy.asarray(array)
-    size = array.dtype.itemsize
-    strides = array.strides
-    if len(strides) == 3 and strides[1]/size == 1 and strides[2]/size == 3:
-        return array.transpose(0, 2, 1)
-    return array
-
 class VTKArray(numpy.matrix):
     """This is a sub-class of numpy ndarray that stores a
     reference to a vtk array as well as the owning dataset.
@@ -83,11 +71,15 @@ class VTKArray(numpy.matrix):
         return obj
 
     def __array_finalize__(self,obj):
-        # Copy the VTK array only if the two share data
-        slf = make_tensor_array_contiguous(self)
-        obj2 = make_tensor_array_contiguous(obj)
-        if hasattr(slf, 'data') and hasattr(obj2, 'data') and \
-          slf.data == obj2.data:
+        # Copy the VTK array only if this is a view of all of obj's data,
+        # e.g. a reshape. Slices such as a[:,0] or a[:5] start at the same
+        # address but cover only part of the VTK array. The addresses are
+        # compared rather than the data buffers, which would compare their
+        # contents for every array numpy creates.
+        if obj is not None and \
+          self.size == obj.size and self.dtype == obj.dtype and \
+          self.__array_interface__['data'][0] == \
+          obj.__array_interface__['data'][0]:
             self.VTKObject = getattr(obj, 'VTKObject', None)
         else:
             self.VTKObject = None
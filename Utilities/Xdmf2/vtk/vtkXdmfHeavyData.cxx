@@ -273,7 +273,16 @@ vtkDataObject* vtkXdmfHeavyData::ReadUniformData(XdmfGrid* xmfGrid)
 
   // Read heavy data for grid geometry/topology. This does not read any
   // data-arrays. They are read explicitly.
-  xmfGrid->Update();
+  if (vtk_data_type == VTK_STRUCTURED_GRID)
+    {
+    // The points of curvilinear grids are read by ReadPoints(), only for the
+    // requested sub-extent when possible. The topology has no heavy data.
+    xmfGrid->GetTopology()->Update();
+    }
+  else
+    {
+    xmfGrid->Update();
+    }
 
   vtkDataObject* dataObject = 0;
 
@@ -761,6 +770,26 @@ vtkPoints* vtkXdmfHeavyData::ReadPoints(XdmfGeometry* xmfGeometry,
     return NULL;
     }
 
+  if (update_extents && whole_extents)
+    {
+    vtkPoints* points = this->ReadStructuredPoints(xmfGeometry,
+      update_extents, whole_extents);
+    if (points)
+      {
+      return points;
+      }
+
+    // The sub-extent cannot be selected from the heavy data, read all the
+    // points.
+    XdmfArray* xmfPoints = xmfGeometry->GetPoints(0);
+    if ((!xmfPoints || xmfPoints->GetNumberOfElements() == 0) &&
+      xmfGeometry->Update() == XDMF_FAIL)
+      {
+      vtkErrorWithObjectMacro(this->Reader, "Failed to read points");
+      return NULL;
+      }
+    }
+
   XdmfArray* xmfPoints = xmfGeometry->GetPoints();
   if (!xmfPoints)
     {
@@ -864,6 +893,123 @@ vtkPoints* vtkXdmfHeavyData::ReadPoints(XdmfGeometry* xmfGeometry,
   return points;
 }
 
+//-----------------------------------------------------------------------------
+vtkPoints* vtkXdmfHeavyData::ReadStructuredPoints(XdmfGeometry* xmfGeometry,
+  int* update_extents, int* whole_extents)
+{
+  int numDataItems = 0;
+  switch (xmfGeometry->GetGeometryType())
+    {
+  case XDMF_GEOMETRY_XYZ:
+    numDataItems = 1;
+    break;
+  case XDMF_GEOMETRY_X_Y_Z:
+    numDataItems = 3;
+    break;
+  default:
+    return NULL;
+    }
+
+  int whole_dims[3];
+  vtkGetDims(whole_extents, whole_dims);
+  int scaled_extents[6];
+  int scaled_dims[3];
+  vtkScaleExtents(update_extents, scaled_extents, this->Stride);
+  vtkGetDims(scaled_extents, scaled_dims);
+  vtkIdType numPoints = static_cast<vtkIdType>(scaled_dims[0]) *
+    scaled_dims[1] * scaled_dims[2];
+
+  // Xdmf's shape is in k,j,i order, with the components last for XYZ.
+  XdmfInt64 start[4] = { update_extents[4], update_extents[2],
+    update_extents[0], 0 };
+  XdmfInt64 stride[4] = { this->Stride[2], this->Stride[1],
+    this->Stride[0], 1 };
+  XdmfInt64 count[4] = { scaled_dims[2], scaled_dims[1], scaled_dims[0], 3 };
+
+  vtkSmartPointer<vtkPoints> points;
+  for (int cc=0; cc < numDataItems; cc++)
+    {
+    XdmfXmlNode element = xmfGeometry->GetDOM()->FindDataElement(cc,
+      xmfGeometry->GetElement());
+    if (!element)
+      {
+      return NULL;
+      }
+    XdmfDataItem xmfDataItem;
+    xmfDataItem.SetDOM(xmfGeometry->GetDOM());
+    if (xmfDataItem.SetElement(element, 0) == XDMF_FAIL ||
+      xmfDataItem.UpdateInformation() == XDMF_FAIL)
+      {
+      return NULL;
+      }
+    xmfDataItem.SetDsmBuffer(xmfGeometry->GetDsmBuffer());
+
+    // Hyperslabs can only be selected when the heavy data is stored with the
+    // shape of the grid.
+    if (xmfDataItem.GetItemType() != XDMF_ITEM_UNIFORM ||
+      xmfDataItem.GetFormat() != XDMF_FORMAT_HDF)
+      {
+      return NULL;
+      }
+    XdmfInt64 data_dims[XDMF_MAX_DIMENSION];
+    int data_rank = xmfDataItem.GetDataDesc()->GetShape(data_dims);
+    int expected_rank = (numDataItems == 1)? 4 : 3;
+    if (data_rank != expected_rank ||
+      data_dims[0] != whole_dims[2] ||
+      data_dims[1] != whole_dims[1] ||
+      data_dims[2] != whole_dims[0] ||
+      (expected_rank == 4 && data_dims[3] != 3))
+      {
+      return NULL;
+      }
+
+    if (!points)
+      {
+      points = vtkSmartPointer<vtkPoints>::New();
+      if (xmfDataItem.GetDataDesc()->GetNumberType() == XDMF_FLOAT32_TYPE)
+        {
+        points->SetDataTypeToFloat();
+        }
+      else
+        {
+        points->SetDataTypeToDouble();
+        }
+      points->SetNumberOfPoints(numPoints);
+      }
+
+    xmfDataItem.GetDataDesc()->SelectHyperSlab(start, stride, count);
+    if (xmfDataItem.Update() == XDMF_FAIL)
+      {
+      return NULL;
+      }
+    XdmfArray* xmfArray = xmfDataItem.GetArray();
+    XdmfInt64 numValues = numPoints * ((numDataItems == 1)? 3 : 1);
+    if (!xmfArray || xmfArray->GetNumberOfElements() != numValues)
+      {
+      return NULL;
+      }
+
+    // For X_Y_Z, the values of each data item are the cc-th component of the
+    // points.
+    int valuesStride = (numDataItems == 1)? 1 : 3;
+    if (points->GetDataType() == VTK_FLOAT)
+      {
+      xmfArray->GetValues(0,
+        reinterpret_cast<float*>(points->GetVoidPointer(0)) + cc,
+        numValues, 1, valuesStride);
+      }
+    else
+      {
+      xmfArray->GetValues(0,
+        reinterpret_cast<double*>(points->GetVoidPointer(0)) + cc,
+        numValues, 1, valuesStride);
+      }
+    }
+
+  points->Register(0);
+  return points;
+}
+
 //-----------------------------------------------------------------------------
 bool vtkXdmfHeavyData::ReadAttributes(
   vtkDataSet* dataSet, XdmfGrid* xmfGrid, int* update_extents)
@@ -112,6 +112,14 @@ private:
     int *update_extents=NULL,
     int *whole_extents=NULL);
 
+  // Description:
+  // Reads the points of the sub-grid given by update_extents and this->Stride
+  // of a vtkStructuredGrid, selecting them from the heavy data with
+  // hyperslabs so that only the needed points are read. Returns NULL when the
+  // geometry is not stored such that this is possible.
+  vtkPoints* ReadStructuredPoints(XdmfGeometry* xmfGeometry,
+    int* update_extents, int* whole_extents);
+
   // Description:
   // Read attributes. 
   bool ReadAttributes(vtkDataSet* dataSet, XdmfGrid* xmfGrid,
@@ -0,0 +1,191 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that vtkFunctionParser::EvaluateBlock() gives the same results
+// as Evaluate() called for each tuple, for every operation of the parser.
+
+#include "vtkFunctionParser.h"
+#include "vtkSmartPointer.h"
+
+#include <vtkstd/vector>
+
+#define VTK_CREATE(type, name) \
+  vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
+
+#define NUMBER_OF_TUPLES 37
+
+// Between them, these functions use every operation of the bytecode.
+static const char* TestFunctions[] = {
+  "-x+2.5",
+  "x-y*3/y",
+  "y^x",
+  "abs(x-0.5)",
+  "exp(x)",
+  "ceil(y)",
+  "floor(y)",
+  "ln(y)",
+  "log10(y)",
+  "sqrt(y)",
+  "sin(x)",
+  "cos(x)",
+  "tan(x)",
+  "asin(x)",
+  "acos(x)",
+  "atan(x)",
+  "sinh(x)",
+  "cosh(x)",
+  "tanh(x)",
+  "min(x,y)",
+  "max(x,y)",
+  "sign(x-0.5)",
+  "cross(v,w)",
+  "-v",
+  "v.w",
+  "v+w",
+  "v-w",
+  "x*v",
+  "v*y",
+  "mag(v)",
+  "norm(w)",
+  "x*iHat+y*jHat-kHat",
+  "if(x<0.5,x,y)",
+  "if(x>0.5,v,w)",
+  "if(x=y|x>0.8&y>1,1,2)",
+  "cross(if(y>1,v,w),v-x*w).norm(v)+max(abs(x-y),ln(y))",
+  0
+};
+
+//-----------------------------------------------------------------------------
+static int CompareBlock(vtkFunctionParser* parser,
+                        const vtkstd::vector<double>* scalars,
+                        const vtkstd::vector<double>* vectors)
+{
+  const double* scalarValues[2] = { &scalars[0][0], &scalars[1][0] };
+  const double* vectorValues[6];
+  for (int i = 0; i < 6; i++)
+    {
+    vectorValues[i] = &vectors[i][0];
+    }
+
+  vtkstd::vector<double> result(3*NUMBER_OF_TUPLES);
+  if (!parser->EvaluateBlock(NUMBER_OF_TUPLES, scalarValues, vectorValues,
+                             &result[0]))
+    {
+    cerr << "EvaluateBlock failed for " << parser->GetFunction() << endl;
+    return 1;
+    }
+
+  for (int t = 0; t < NUMBER_OF_TUPLES; t++)
+    {
+    parser->SetScalarVariableValue("x", scalars[0][t]);
+    parser->SetScalarVariableValue("y", scalars[1][t]);
+    parser->SetVectorVariableValue("v", vectors[0][t], vectors[1][t],
+                                   vectors[2][t]);
+    parser->SetVectorVariableValue("w", vectors[3][t], vectors[4][t],
+                                   vectors[5][t]);
+    if (parser->IsScalarResult())
+      {
+      if (parser->GetScalarResult() != result[t])
+        {
+        cerr << parser->GetFunction() << ": tuple " << t << " is "
+             << result[t] << " instead of " << parser->GetScalarResult()
+             << endl;
+        return 1;
+        }
+      }
+    else if (parser->IsVectorResult())
+      {
+      double* expected = parser->GetVectorResult();
+      for (int c = 0; c < 3; c++)
+        {
+        if (expected[c] != result[3*t+c])
+          {
+          cerr << parser->GetFunction() << ": component " << c
+               << " of tuple " << t << " is " << result[3*t+c]
+               << " instead of " << expected[c] << endl;
+          return 1;
+          }
+        }
+      }
+    else
+      {
+      cerr << "Evaluate failed for " << parser->GetFunction() << endl;
+      return 1;
+      }
+    }
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+int TestFunctionParserBlock(int, char*[])
+{
+  // x is in (0, 1) and y is positive, so that all the functions are
+  // defined. y equals x for some tuples to test the equality.
+  vtkstd::vector<double> scalars[2];
+  vtkstd::vector<double> vectors[6];
+  for (int t = 0; t < NUMBER_OF_TUPLES; t++)
+    {
+    double x = 0.05 + 0.9*t/NUMBER_OF_TUPLES;
+    scalars[0].push_back(x);
+    scalars[1].push_back(t % 5 == 0 ? x : 0.3 + 0.17*t);
+    for (int c = 0; c < 6; c++)
+      {
+      vectors[c].push_back(((t*7 + c*3) % 11) - 4.5);
+      }
+    }
+
+  VTK_CREATE(vtkFunctionParser, parser);
+  parser->SetScalarVariableValue("x", 0.0);
+  parser->SetScalarVariableValue("y", 0.0);
+  parser->SetVectorVariableValue("v", 0.0, 0.0, 0.0);
+  parser->SetVectorVariableValue("w", 0.0, 0.0, 0.0);
+
+  int errors = 0;
+  for (int i = 0; TestFunctions[i]; i++)
+    {
+    parser->SetFunction(TestFunctions[i]);
+    errors += CompareBlock(parser, scalars, vectors);
+    }
+
+  // log() is deprecated and reports an error when parsed.
+  vtkObject::GlobalWarningDisplayOff();
+  parser->SetFunction("log(y)");
+  errors += CompareBlock(parser, scalars, vectors);
+  vtkObject::GlobalWarningDisplayOn();
+
+  // Invalid values are replaced the same way in both.
+  parser->ReplaceInvalidValuesOn();
+  parser->SetReplacementValue(-7.0);
+  parser->SetFunction("ln(x-0.5)+sqrt(0.5-x)/(x-y)");
+  errors += CompareBlock(parser, scalars, vectors);
+
+  // Without replacement, EvaluateBlock() fails without reporting an error.
+  parser->ReplaceInvalidValuesOff();
+  parser->SetFunction("ln(x-0.5)");
+  const double* scalarValues[2] = { &scalars[0][0], &scalars[1][0] };
+  const double* vectorValues[6];
+  for (int c = 0; c < 6; c++)
+    {
+    vectorValues[c] = &vectors[c][0];
+    }
+  double result[3*NUMBER_OF_TUPLES];
+  if (parser->EvaluateBlock(NUMBER_OF_TUPLES, scalarValues, vectorValues,
+                            result))
+    {
+    cerr << "EvaluateBlock should fail for " << parser->GetFunction() << endl;
+    errors++;
+    }
+
+  return errors;
+}
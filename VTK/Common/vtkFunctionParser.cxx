@@ -16,6 +16,7 @@
 #include "vtkObjectFactory.h"
 
 #include <ctype.h>
+#include <vtkstd/vector>
 
 vtkCxxRevisionMacro(vtkFunctionParser, "$Revision$");
 vtkStandardNewMacro(vtkFunctionParser);
@@ -952,6 +953,484 @@ bool vtkFunctionParser::Evaluate()
   return true;
 }
 
+// The stack of EvaluateBlock() holds numberOfTuples values per entry, so
+// each operation of the bytecode is applied to the whole block in a loop.
+bool vtkFunctionParser::EvaluateBlock(vtkIdType numberOfTuples,
+                                      const double* const* scalarValues,
+                                      const double* const* vectorValues,
+                                      double* result)
+{
+  if (this->FunctionMTime.GetMTime() > this->ParseMTime.GetMTime())
+    {
+    if (this->Parse() == 0)
+      {
+      return false;
+      }
+    }
+  if (numberOfTuples <= 0 || this->StackSize == 0)
+    {
+    return false;
+    }
+
+  const vtkIdType n = numberOfTuples;
+  vtkstd::vector<double> block(this->StackSize * n);
+  double* stack = &block[0];
+  int numImmediatesProcessed = 0;
+  int stackPosition = -1;
+  double* a;
+  double* b;
+  double* c;
+  vtkIdType t;
+
+  for (int numBytesProcessed = 0; numBytesProcessed < this->ByteCodeSize;
+       numBytesProcessed++)
+    {
+    // b is the top of the stack and a the entry below it.
+    b = stack + stackPosition*n;
+    a = b - n;
+    switch (this->ByteCode[numBytesProcessed])
+      {
+      case VTK_PARSER_IMMEDIATE:
+        {
+        double value = this->Immediates[numImmediatesProcessed++];
+        c = stack + (++stackPosition)*n;
+        for (t = 0; t < n; t++)
+          {
+          c[t] = value;
+          }
+        break;
+        }
+      case VTK_PARSER_UNARY_MINUS:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = -b[t];
+          }
+        break;
+      case VTK_PARSER_ADD:
+        for (t = 0; t < n; t++)
+          {
+          a[t] += b[t];
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_SUBTRACT:
+        for (t = 0; t < n; t++)
+          {
+          a[t] -= b[t];
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_MULTIPLY:
+        for (t = 0; t < n; t++)
+          {
+          a[t] *= b[t];
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_DIVIDE:
+        for (t = 0; t < n; t++)
+          {
+          if (b[t] == 0)
+            {
+            if (!this->ReplaceInvalidValues)
+              {
+              return false;
+              }
+            a[t] = this->ReplacementValue;
+            }
+          else
+            {
+            a[t] /= b[t];
+            }
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_POWER:
+        for (t = 0; t < n; t++)
+          {
+          a[t] = pow(a[t], b[t]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_ABSOLUTE_VALUE:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = fabs(b[t]);
+          }
+        break;
+      case VTK_PARSER_EXPONENT:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = exp(b[t]);
+          }
+        break;
+      case VTK_PARSER_CEILING:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = ceil(b[t]);
+          }
+        break;
+      case VTK_PARSER_FLOOR:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = floor(b[t]);
+          }
+        break;
+      case VTK_PARSER_LOGARITHM:
+      case VTK_PARSER_LOGARITHME:
+      case VTK_PARSER_LOGARITHM10:
+        {
+        double divisor = 1.0;
+        if (this->ByteCode[numBytesProcessed] == VTK_PARSER_LOGARITHM10)
+          {
+          divisor = log(static_cast<double>(10));
+          }
+        for (t = 0; t < n; t++)
+          {
+          if (b[t] <= 0)
+            {
+            if (!this->ReplaceInvalidValues)
+              {
+              return false;
+              }
+            b[t] = this->ReplacementValue;
+            }
+          else
+            {
+            b[t] = log(b[t])/divisor;
+            }
+          }
+        break;
+        }
+      case VTK_PARSER_SQUARE_ROOT:
+        for (t = 0; t < n; t++)
+          {
+          if (b[t] < 0)
+            {
+            if (!this->ReplaceInvalidValues)
+              {
+              return false;
+              }
+            b[t] = this->ReplacementValue;
+            }
+          else
+            {
+            b[t] = sqrt(b[t]);
+            }
+          }
+        break;
+      case VTK_PARSER_SINE:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = sin(b[t]);
+          }
+        break;
+      case VTK_PARSER_COSINE:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = cos(b[t]);
+          }
+        break;
+      case VTK_PARSER_TANGENT:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = tan(b[t]);
+          }
+        break;
+      case VTK_PARSER_ARCSINE:
+      case VTK_PARSER_ARCCOSINE:
+        {
+        bool isArcSine =
+          (this->ByteCode[numBytesProcessed] == VTK_PARSER_ARCSINE);
+        for (t = 0; t < n; t++)
+          {
+          if (b[t] < -1 || b[t] > 1)
+            {
+            if (!this->ReplaceInvalidValues)
+              {
+              return false;
+              }
+            b[t] = this->ReplacementValue;
+            }
+          else
+            {
+            b[t] = isArcSine ? asin(b[t]) : acos(b[t]);
+            }
+          }
+        break;
+        }
+      case VTK_PARSER_ARCTANGENT:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = atan(b[t]);
+          }
+        break;
+      case VTK_PARSER_HYPERBOLIC_SINE:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = sinh(b[t]);
+          }
+        break;
+      case VTK_PARSER_HYPERBOLIC_COSINE:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = cosh(b[t]);
+          }
+        break;
+      case VTK_PARSER_HYPERBOLIC_TANGENT:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = tanh(b[t]);
+          }
+        break;
+      case VTK_PARSER_MIN:
+        for (t = 0; t < n; t++)
+          {
+          a[t] = (b[t] < a[t]) ? b[t] : a[t];
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_MAX:
+        for (t = 0; t < n; t++)
+          {
+          a[t] = (b[t] > a[t]) ? b[t] : a[t];
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_CROSS:
+        {
+        double* ux = stack + (stackPosition-5)*n;
+        double* uy = ux + n;
+        double* uz = uy + n;
+        double* vx = uz + n;
+        double* vy = vx + n;
+        double* vz = vy + n;
+        for (t = 0; t < n; t++)
+          {
+          double x = uy[t]*vz[t] - uz[t]*vy[t];
+          double y = uz[t]*vx[t] - ux[t]*vz[t];
+          double z = ux[t]*vy[t] - uy[t]*vx[t];
+          ux[t] = x;
+          uy[t] = y;
+          uz[t] = z;
+          }
+        stackPosition -= 3;
+        break;
+        }
+      case VTK_PARSER_SIGN:
+        for (t = 0; t < n; t++)
+          {
+          b[t] = (b[t] < 0) ? -1 : ((b[t] == 0) ? 0 : 1);
+          }
+        break;
+      case VTK_PARSER_VECTOR_UNARY_MINUS:
+        for (t = 0; t < 3*n; t++)
+          {
+          b[t-2*n] = -b[t-2*n];
+          }
+        break;
+      case VTK_PARSER_DOT_PRODUCT:
+        {
+        double* ux = stack + (stackPosition-5)*n;
+        double* uy = ux + n;
+        double* uz = uy + n;
+        double* vx = uz + n;
+        double* vy = vx + n;
+        double* vz = vy + n;
+        for (t = 0; t < n; t++)
+          {
+          ux[t] = ux[t]*vx[t] + uy[t]*vy[t] + uz[t]*vz[t];
+          }
+        stackPosition -= 5;
+        break;
+        }
+      case VTK_PARSER_VECTOR_ADD:
+        c = stack + (stackPosition-5)*n;
+        for (t = 0; t < 3*n; t++)
+          {
+          c[t] += c[t+3*n];
+          }
+        stackPosition -= 3;
+        break;
+      case VTK_PARSER_VECTOR_SUBTRACT:
+        c = stack + (stackPosition-5)*n;
+        for (t = 0; t < 3*n; t++)
+          {
+          c[t] -= c[t+3*n];
+          }
+        stackPosition -= 3;
+        break;
+      case VTK_PARSER_SCALAR_TIMES_VECTOR:
+        {
+        // The scalar is below the vector, which moves down one entry.
+        c = stack + (stackPosition-3)*n;
+        for (t = 0; t < n; t++)
+          {
+          double scalar = c[t];
+          c[t] = c[t+n]*scalar;
+          c[t+n] = c[t+2*n]*scalar;
+          c[t+2*n] = c[t+3*n]*scalar;
+          }
+        stackPosition--;
+        break;
+        }
+      case VTK_PARSER_VECTOR_TIMES_SCALAR:
+        c = stack + (stackPosition-3)*n;
+        for (t = 0; t < 3*n; t++)
+          {
+          c[t] *= b[t%n];
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_MAGNITUDE:
+        {
+        double* x = stack + (stackPosition-2)*n;
+        double* y = x + n;
+        double* z = y + n;
+        for (t = 0; t < n; t++)
+          {
+          x[t] = sqrt(z[t]*z[t] + y[t]*y[t] + x[t]*x[t]);
+          }
+        stackPosition -= 2;
+        break;
+        }
+      case VTK_PARSER_NORMALIZE:
+        {
+        double* x = stack + (stackPosition-2)*n;
+        double* y = x + n;
+        double* z = y + n;
+        for (t = 0; t < n; t++)
+          {
+          double magnitude = sqrt(z[t]*z[t] + y[t]*y[t] + x[t]*x[t]);
+          if (magnitude != 0)
+            {
+            x[t] /= magnitude;
+            y[t] /= magnitude;
+            z[t] /= magnitude;
+            }
+          }
+        break;
+        }
+      case VTK_PARSER_IHAT:
+      case VTK_PARSER_JHAT:
+      case VTK_PARSER_KHAT:
+        {
+        int axis = this->ByteCode[numBytesProcessed] - VTK_PARSER_IHAT;
+        c = stack + (stackPosition+1)*n;
+        for (t = 0; t < 3*n; t++)
+          {
+          c[t] = (t/n == axis) ? 1 : 0;
+          }
+        stackPosition += 3;
+        break;
+        }
+      case VTK_PARSER_LESS_THAN:
+        for (t = 0; t < n; t++)
+          {
+          a[t] = (a[t] < b[t]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_GREATER_THAN:
+        for (t = 0; t < n; t++)
+          {
+          a[t] = (a[t] > b[t]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_EQUAL_TO:
+        for (t = 0; t < n; t++)
+          {
+          a[t] = (a[t] == b[t]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_AND:
+        for (t = 0; t < n; t++)
+          {
+          a[t] = (a[t] && b[t]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_OR:
+        for (t = 0; t < n; t++)
+          {
+          a[t] = (a[t] || b[t]);
+          }
+        stackPosition--;
+        break;
+      case VTK_PARSER_IF:
+        {
+        // Same layout as in Evaluate(): the false value, the true value and
+        // the boolean argument on top.
+        double* valFalse = stack + (stackPosition-2)*n;
+        double* valTrue = valFalse + n;
+        for (t = 0; t < n; t++)
+          {
+          if (b[t])
+            {
+            valFalse[t] = valTrue[t];
+            }
+          }
+        stackPosition -= 2;
+        break;
+        }
+      case VTK_PARSER_VECTOR_IF:
+        {
+        double* valFalse = stack + (stackPosition-6)*n;
+        double* valTrue = valFalse + 3*n;
+        for (t = 0; t < 3*n; t++)
+          {
+          if (b[t%n])
+            {
+            valFalse[t] = valTrue[t];
+            }
+          }
+        stackPosition -= 4;
+        break;
+        }
+      default:
+        if ((this->ByteCode[numBytesProcessed] -
+             VTK_PARSER_BEGIN_VARIABLES) < this->NumberOfScalarVariables)
+          {
+          c = stack + (++stackPosition)*n;
+          memcpy(c, scalarValues[this->ByteCode[numBytesProcessed] -
+                                 VTK_PARSER_BEGIN_VARIABLES],
+                 n*sizeof(double));
+          }
+        else
+          {
+          int vectorNum = this->ByteCode[numBytesProcessed] -
+            VTK_PARSER_BEGIN_VARIABLES - this->NumberOfScalarVariables;
+          for (int comp = 0; comp < 3; comp++)
+            {
+            c = stack + (++stackPosition)*n;
+            memcpy(c, vectorValues[3*vectorNum+comp], n*sizeof(double));
+            }
+          }
+      }
+    }
+
+  if (stackPosition == 0)
+    {
+    memcpy(result, stack, n*sizeof(double));
+    }
+  else if (stackPosition == 2)
+    {
+    for (t = 0; t < n; t++)
+      {
+      result[3*t] = stack[t];
+      result[3*t+1] = stack[n+t];
+      result[3*t+2] = stack[2*n+t];
+      }
+    }
+  else
+    {
+    return false;
+    }
+  return true;
+}
+
 int vtkFunctionParser::IsScalarResult()
 {
   if (this->VariableMTime.GetMTime() > this->EvaluateMTime.GetMTime() || 
@@ -2051,6 +2530,7 @@ int vtkFunctionParser::GetMathFunctionStringLength(int mathFunctionNumber)
     case VTK_PARSER_HYPERBOLIC_COSINE:
     case VTK_PARSER_HYPERBOLIC_TANGENT:
     case VTK_PARSER_NORMALIZE:
+    case VTK_PARSER_SIGN:
       return 4;
     case VTK_PARSER_FLOOR:
     case VTK_PARSER_LOGARITHM10:
@@ -145,6 +145,26 @@ public:
     double *r = this->GetVectorResult();
     result[0] = r[0]; result[1] = r[1]; result[2] = r[2]; };
 
+//BTX
+  // Description:
+  // Evaluate the function for a block of numberOfTuples tuples at once,
+  // interpreting the bytecode once for the whole block. scalarValues[i]
+  // points to the numberOfTuples values of the ith scalar variable and
+  // vectorValues[3*i+j] to those of component j of the ith vector variable;
+  // the values set with Set*VariableValue() are not used. One value per
+  // tuple is written to result for a scalar function and three for a
+  // vector function, so result must hold 3*numberOfTuples values unless
+  // IsScalarResult() is known to be true. The parser is not modified once
+  // the function has been parsed (e.g. by IsScalarResult()), so blocks may
+  // be evaluated concurrently. Returns false, without reporting an error,
+  // if the function cannot be evaluated for one of the tuples; setting the
+  // variables and evaluating the tuples one by one reports the errors.
+  bool EvaluateBlock(vtkIdType numberOfTuples,
+                     const double* const* scalarValues,
+                     const double* const* vectorValues,
+                     double* result);
+//ETX
+
   // Description:
   // Set the value of a scalar variable.  If a variable with this name
   // exists, then its value will be set to the new value.  If there is not
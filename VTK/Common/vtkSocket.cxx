@@ -410,6 +410,38 @@ int vtkSocket::Receive(void* data, int length, int readFully/*=1*/)
 #endif
 }
 
+//-----------------------------------------------------------------------------
+int vtkSocket::Peek(void* data, int length)
+{
+#ifndef VTK_SOCKET_FAKE_API
+  if (!this->GetConnected() || length <= 0)
+    {
+    return 0;
+    }
+
+  // Poll the socket: SelectSocket() treats a 0 timeout as "wait forever".
+  fd_set rset;
+  struct timeval tval;
+  tval.tv_sec = 0;
+  tval.tv_usec = 0;
+  FD_ZERO(&rset);
+  FD_SET(this->SocketDescriptor, &rset);
+  if (select(this->SocketDescriptor + 1, &rset, 0, 0, &tval) <= 0 ||
+    !FD_ISSET(this->SocketDescriptor, &rset))
+    {
+    return 0;
+    }
+
+  int n = recv(this->SocketDescriptor, reinterpret_cast<char*>(data),
+    length, MSG_PEEK);
+  return (n > 0)? n : 0;
+#else
+  static_cast<void>(data);
+  static_cast<void>(length);
+  return 0;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 void vtkSocket::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -53,6 +53,13 @@ public:
   // vtkCommand::ErrorEvent is raised.
   int Receive(void* data, int length, int readFully=1);
 
+  // Description:
+  // Copy up to length bytes of the data already received on the socket
+  // into data, without removing them from the socket. This call never
+  // blocks. Returns the number of bytes copied, 0 when no data is
+  // available or on error.
+  int Peek(void* data, int length);
+
 protected:
   vtkSocket();
   ~vtkSocket();
@@ -0,0 +1,128 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that vtkArrayCalculator gives the same results whether the
+// function is evaluated by one thread or by several.
+
+#include "vtkArrayCalculator.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+#define VTK_CREATE(type, name) \
+  vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
+
+// More tuples than fit in a few blocks of the calculator.
+#define NUMBER_OF_TUPLES 10000
+
+static const char* TestFunctions[] = {
+  "f*coordsX + i1 - mag(v)",
+  "sqrt(f)",
+  "cross(v,coords) + f*iHat",
+  "if(f>2, v, coords) - i0*jHat",
+  "(v.coords)/i1",
+  0
+};
+
+//-----------------------------------------------------------------------------
+static vtkSmartPointer<vtkDataArray> Calculate(vtkPolyData* input,
+                                               const char* function,
+                                               int numberOfThreads)
+{
+  VTK_CREATE(vtkArrayCalculator, calc);
+  calc->SetInput(input);
+  calc->SetAttributeModeToUsePointData();
+  calc->AddScalarArrayName("f");
+  calc->AddScalarVariable("i0", "i", 0);
+  calc->AddScalarVariable("i1", "i", 1);
+  calc->AddVectorArrayName("v");
+  calc->AddCoordinateScalarVariable("coordsX", 0);
+  calc->AddCoordinateVectorVariable("coords");
+  calc->ReplaceInvalidValuesOn();
+  calc->SetReplacementValue(-1.0);
+  calc->SetFunction(function);
+  calc->SetResultArrayName("result");
+  calc->SetNumberOfThreads(numberOfThreads);
+  calc->Update();
+  return vtkPolyData::SafeDownCast(calc->GetOutput())
+    ->GetPointData()->GetArray("result");
+}
+
+//-----------------------------------------------------------------------------
+int TestArrayCalculatorThreads(int, char*[])
+{
+  VTK_CREATE(vtkPoints, points);
+  VTK_CREATE(vtkFloatArray, f);
+  f->SetName("f");
+  VTK_CREATE(vtkIntArray, i);
+  i->SetName("i");
+  i->SetNumberOfComponents(2);
+  VTK_CREATE(vtkDoubleArray, v);
+  v->SetName("v");
+  v->SetNumberOfComponents(3);
+  for (int t = 0; t < NUMBER_OF_TUPLES; t++)
+    {
+    points->InsertNextPoint((t % 100)/7.0, (t % 37)/9.0 - 2.0, (t % 11)/3.0);
+    f->InsertNextValue((t % 1000)/100.0 - 2.0);
+    i->InsertNextTuple2(t % 10 - 3, t % 5);
+    v->InsertNextTuple3(t % 7 - 3, t % 5, (t % 3)*0.5);
+    }
+  VTK_CREATE(vtkPolyData, input);
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(f);
+  input->GetPointData()->AddArray(i);
+  input->GetPointData()->AddArray(v);
+
+  int errors = 0;
+  for (int k = 0; TestFunctions[k]; k++)
+    {
+    vtkSmartPointer<vtkDataArray> serial =
+      Calculate(input, TestFunctions[k], 1);
+    vtkSmartPointer<vtkDataArray> threaded =
+      Calculate(input, TestFunctions[k], 4);
+    if (!serial || !threaded ||
+        serial->GetNumberOfTuples() != NUMBER_OF_TUPLES ||
+        threaded->GetNumberOfTuples() != NUMBER_OF_TUPLES ||
+        serial->GetNumberOfComponents() != threaded->GetNumberOfComponents())
+      {
+      cerr << TestFunctions[k] << ": missing or mismatched result arrays."
+           << endl;
+      errors++;
+      continue;
+      }
+    int numComponents = serial->GetNumberOfComponents();
+    vtkIdType numValues = NUMBER_OF_TUPLES*numComponents;
+    for (vtkIdType j = 0; j < numValues; j++)
+      {
+      vtkIdType t = j / numComponents;
+      int c = static_cast<int>(j % numComponents);
+      if (serial->GetComponent(t, c) != threaded->GetComponent(t, c))
+        {
+        cerr << TestFunctions[k] << ": component " << c << " of tuple "
+             << t << " is " << threaded->GetComponent(t, c)
+             << " with 4 threads and " << serial->GetComponent(t, c)
+             << " with 1." << endl;
+        errors++;
+        break;
+        }
+      }
+    }
+
+  return errors;
+}
@@ -22,12 +22,15 @@
 #include "vtkGraph.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vtkstd/vector>
+
 vtkCxxRevisionMacro(vtkArrayCalculator, "$Revision$");
 vtkStandardNewMacro(vtkArrayCalculator);
 
@@ -59,6 +62,7 @@ vtkArrayCalculator::vtkArrayCalculator()
   this->ReplacementValue = 0.0;
 
   this->ResultArrayType=VTK_DOUBLE;
+  this->NumberOfThreads = 1;
 }
 
 vtkArrayCalculator::~vtkArrayCalculator()
@@ -202,6 +206,169 @@ void vtkArrayCalculator::SetResultArrayName(const char* name)
   strcpy(this->ResultArrayName, name);
 }
 
+// Number of tuples evaluated at once by vtkFunctionParser::EvaluateBlock().
+static const vtkIdType vtkArrayCalculatorBlockSize = 1024;
+
+// Where the values of a variable of the parser come from: a component of an
+// array, a coordinate of the points read with GetPoint() or a constant.
+struct vtkArrayCalculatorSource
+{
+  vtkArrayCalculatorSource() :
+    Array(0), Component(0), Coordinate(false), Value(0.0) {}
+
+  vtkDataArray* Array;
+  int Component;
+  bool Coordinate;
+  double Value;
+};
+
+// The work shared by the threads evaluating the blocks of tuples.
+struct vtkArrayCalculatorBlocks
+{
+  vtkFunctionParser* Parser;
+  vtkDataSet* DataSet;
+  vtkGraph* Graph;
+  vtkstd::vector<vtkArrayCalculatorSource> Scalars;
+  vtkstd::vector<vtkArrayCalculatorSource> Vectors; // 3 per vector variable
+  vtkDataArray* Result;
+  int ResultComponents;
+  vtkIdType NumberOfTuples;
+  vtkIdType NumberOfBlocks;
+  vtkstd::vector<char> Failed; // blocks EvaluateBlock() failed for
+};
+
+template <class T>
+void vtkArrayCalculatorGatherValues(const T* data, int numComps, vtkIdType n,
+                                    double* values)
+{
+  for (vtkIdType t = 0; t < n; t++)
+    {
+    values[t] = static_cast<double>(data[t*numComps]);
+    }
+}
+
+static void vtkArrayCalculatorGather(vtkArrayCalculatorBlocks* blocks,
+                                     const vtkArrayCalculatorSource& source,
+                                     vtkIdType begin, vtkIdType n,
+                                     double* values)
+{
+  vtkIdType t;
+  if (source.Array)
+    {
+    int numComps = source.Array->GetNumberOfComponents();
+    switch (source.Array->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkArrayCalculatorGatherValues(static_cast<VTK_TT*>(
+            source.Array->GetVoidPointer(begin*numComps + source.Component)),
+          numComps, n, values));
+      default:
+        for (t = 0; t < n; t++)
+          {
+          values[t] = source.Array->GetComponent(begin+t, source.Component);
+          }
+      }
+    }
+  else if (source.Coordinate)
+    {
+    for (t = 0; t < n; t++)
+      {
+      double* pt = blocks->DataSet ? blocks->DataSet->GetPoint(begin+t) :
+        blocks->Graph->GetPoint(begin+t);
+      values[t] = pt[source.Component];
+      }
+    }
+  else
+    {
+    for (t = 0; t < n; t++)
+      {
+      values[t] = source.Value;
+      }
+    }
+}
+
+template <class T>
+void vtkArrayCalculatorScatterValues(T* data, const double* values,
+                                     vtkIdType n)
+{
+  for (vtkIdType t = 0; t < n; t++)
+    {
+    data[t] = static_cast<T>(values[t]);
+    }
+}
+
+// Evaluates the blocks first, first+step, first+2*step...
+static void vtkArrayCalculatorEvaluateBlocks(vtkArrayCalculatorBlocks* blocks,
+                                             vtkIdType first, vtkIdType step)
+{
+  const vtkIdType blockSize = vtkArrayCalculatorBlockSize;
+  size_t numScalars = blocks->Scalars.size();
+  size_t numVectorValues = blocks->Vectors.size();
+  vtkstd::vector<double> values((numScalars + numVectorValues + 3)*blockSize);
+  vtkstd::vector<double*> scalarValues(numScalars + 1);
+  vtkstd::vector<double*> vectorValues(numVectorValues + 1);
+  size_t k;
+  for (k = 0; k < numScalars; k++)
+    {
+    scalarValues[k] = &values[k*blockSize];
+    }
+  for (k = 0; k < numVectorValues; k++)
+    {
+    vectorValues[k] = &values[(numScalars + k)*blockSize];
+    }
+  double* result = &values[(numScalars + numVectorValues)*blockSize];
+  vtkDataArray* resultArray = blocks->Result;
+  int numComps = blocks->ResultComponents;
+
+  for (vtkIdType block = first; block < blocks->NumberOfBlocks; block += step)
+    {
+    vtkIdType begin = block*blockSize;
+    vtkIdType n = blocks->NumberOfTuples - begin;
+    if (n > blockSize)
+      {
+      n = blockSize;
+      }
+    for (k = 0; k < numScalars; k++)
+      {
+      vtkArrayCalculatorGather(blocks, blocks->Scalars[k], begin, n,
+                               scalarValues[k]);
+      }
+    for (k = 0; k < numVectorValues; k++)
+      {
+      vtkArrayCalculatorGather(blocks, blocks->Vectors[k], begin, n,
+                               vectorValues[k]);
+      }
+    if (!blocks->Parser->EvaluateBlock(n, &scalarValues[0], &vectorValues[0],
+                                       result))
+      {
+      blocks->Failed[block] = 1;
+      continue;
+      }
+    switch (resultArray->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkArrayCalculatorScatterValues(static_cast<VTK_TT*>(
+            resultArray->GetVoidPointer(begin*numComps)), result,
+          n*numComps));
+      default:
+        for (vtkIdType t = 0; t < n; t++)
+          {
+          resultArray->SetTuple(begin+t, result + t*numComps);
+          }
+      }
+    }
+}
+
+static VTK_THREAD_RETURN_TYPE vtkArrayCalculatorThreadedEvaluate(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkArrayCalculatorEvaluateBlocks(
+    static_cast<vtkArrayCalculatorBlocks*>(info->UserData),
+    info->ThreadID, info->NumberOfThreads);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 int vtkArrayCalculator::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -429,75 +596,159 @@ int vtkArrayCalculator::RequestData(
         vtkDataArray::SafeDownCast(vtkAbstractArray::CreateArray(this->ResultArrayType));
     }
 
+  int resultComponents = (resultType == 0) ? 1 : 3;
   if (resultType == 0)
     {
     resultArray->SetNumberOfComponents(1);
     resultArray->SetNumberOfTuples(numTuples);
-    scalarResult[0] = this->FunctionParser->GetScalarResult();
-    resultArray->SetTuple(0, scalarResult);
     }
   else
     {
     resultArray->Allocate(numTuples * 3);
     resultArray->SetNumberOfComponents(3);
     resultArray->SetNumberOfTuples(numTuples);
-    resultArray->SetTuple(0, this->FunctionParser->GetVectorResult());
     }
-  
-  for (i = 1; i < numTuples; i++)
+
+  // Find where the values of the variables of the parser come from. The
+  // variables were added to the parser in the order of the arrays above.
+  vtkArrayCalculatorBlocks blocks;
+  blocks.Parser = this->FunctionParser;
+  blocks.DataSet = dsInput;
+  blocks.Graph = graphInput;
+  blocks.Result = resultArray;
+  blocks.ResultComponents = resultComponents;
+  blocks.NumberOfTuples = numTuples;
+  blocks.NumberOfBlocks = (numTuples + vtkArrayCalculatorBlockSize - 1) /
+    vtkArrayCalculatorBlockSize;
+  blocks.Failed.assign(blocks.NumberOfBlocks, 0);
+
+  vtkDataArray* points = 0;
+  if (attributeDataType == 0 && psInput && psInput->GetPoints())
+    {
+    points = psInput->GetPoints()->GetData();
+    }
+  int numScalars = this->FunctionParser->GetNumberOfScalarVariables();
+  blocks.Scalars.resize(numScalars);
+  for (j = 0; j < numScalars; j++)
     {
-    for (j = 0; j < this->NumberOfScalarArrays; j++)
+    vtkArrayCalculatorSource& source = blocks.Scalars[j];
+    int coordinate = j - this->NumberOfScalarArrays;
+    if (j < this->NumberOfScalarArrays)
       {
-      currentArray = inFD->GetArray(this->ScalarArrayNames[j]);
-      this->FunctionParser->
-        SetScalarVariableValue(
-          j, currentArray->GetComponent(i, this->SelectedScalarComponents[j]));
+      source.Array = inFD->GetArray(this->ScalarArrayNames[j]);
+      source.Component = this->SelectedScalarComponents[j];
       }
-    for (j = 0; j < this->NumberOfVectorArrays; j++)
+    else if (attributeDataType == 0 &&
+             coordinate < this->NumberOfCoordinateScalarArrays)
       {
-      currentArray = inFD->GetArray(this->VectorArrayNames[j]);
-      this->FunctionParser->
-        SetVectorVariableValue(
-          j, currentArray->GetComponent(i, this->SelectedVectorComponents[j][0]),
-          currentArray->GetComponent(
-            i, this->SelectedVectorComponents[j][1]),
-          currentArray->GetComponent(i, this->SelectedVectorComponents[j][2]));
+      source.Array = points;
+      source.Coordinate = (points == 0);
+      source.Component = this->SelectedCoordinateScalarComponents[coordinate];
       }
-    if(attributeDataType == 0)
+    else
       {
-      double* pt = 0;
-      if (dsInput)
-        {
-        pt = dsInput->GetPoint(i);
-        }
-      else
+      source.Value = this->FunctionParser->GetScalarVariableValue(j);
+      }
+    }
+  int numVectors = this->FunctionParser->GetNumberOfVectorVariables();
+  blocks.Vectors.resize(3*numVectors);
+  for (j = 0; j < numVectors; j++)
+    {
+    int coordinate = j - this->NumberOfVectorArrays;
+    double* value = this->FunctionParser->GetVectorVariableValue(j);
+    for (int comp = 0; comp < 3; comp++)
+      {
+      vtkArrayCalculatorSource& source = blocks.Vectors[3*j+comp];
+      if (j < this->NumberOfVectorArrays)
         {
-        pt = graphInput->GetPoint(i);
+        source.Array = inFD->GetArray(this->VectorArrayNames[j]);
+        source.Component = this->SelectedVectorComponents[j][comp];
         }
-      for (j = 0; j < this->NumberOfCoordinateScalarArrays; j++)
+      else if (attributeDataType == 0 &&
+               coordinate < this->NumberOfCoordinateVectorArrays)
         {
-        this->FunctionParser->
-          SetScalarVariableValue(
-            j+this->NumberOfScalarArrays, pt[this->SelectedCoordinateScalarComponents[j]]);
+        source.Array = points;
+        source.Coordinate = (points == 0);
+        source.Component =
+          this->SelectedCoordinateVectorComponents[coordinate][comp];
         }
-      for (j = 0; j < this->NumberOfCoordinateVectorArrays; j++)
+      else
         {
-        this->FunctionParser->
-          SetVectorVariableValue(
-            j+this->NumberOfVectorArrays,
-            pt[this->SelectedCoordinateVectorComponents[j][0]],
-            pt[this->SelectedCoordinateVectorComponents[j][1]],
-            pt[this->SelectedCoordinateVectorComponents[j][2]]);
+        source.Value = value[comp];
         }
       }
-    if (resultType == 0)
+    }
+
+  // Reading coordinates through GetPoint() and accessing bit arrays is not
+  // thread safe.
+  int numThreads = this->NumberOfThreads;
+  if (resultArray->GetDataType() == VTK_BIT)
+    {
+    numThreads = 1;
+    }
+  for (j = 0; j < numScalars + 3*numVectors; j++)
+    {
+    const vtkArrayCalculatorSource& source = (j < numScalars) ?
+      blocks.Scalars[j] : blocks.Vectors[j-numScalars];
+    if (source.Coordinate ||
+        (source.Array && source.Array->GetDataType() == VTK_BIT))
       {
-      scalarResult[0] = this->FunctionParser->GetScalarResult();
-      resultArray->SetTuple(i, scalarResult);
+      numThreads = 1;
       }
-    else
+    }
+  if (numThreads > blocks.NumberOfBlocks)
+    {
+    numThreads = static_cast<int>(blocks.NumberOfBlocks);
+    }
+
+  if (numThreads > 1)
+    {
+    vtkMultiThreader* threader = vtkMultiThreader::New();
+    threader->SetNumberOfThreads(numThreads);
+    threader->SetSingleMethod(vtkArrayCalculatorThreadedEvaluate, &blocks);
+    threader->SingleMethodExecute();
+    threader->Delete();
+    }
+  else
+    {
+    vtkArrayCalculatorEvaluateBlocks(&blocks, 0, 1);
+    }
+
+  // Evaluate the blocks for which the parser failed one tuple at a time, so
+  // that the invalid values are reported as usual.
+  for (vtkIdType block = 0; block < blocks.NumberOfBlocks; block++)
+    {
+    if (!blocks.Failed[block])
+      {
+      continue;
+      }
+    vtkIdType end = (block + 1)*vtkArrayCalculatorBlockSize;
+    for (i = block*vtkArrayCalculatorBlockSize; i < end && i < numTuples; i++)
       {
-      resultArray->SetTuple(i, this->FunctionParser->GetVectorResult());
+      double value[3];
+      for (j = 0; j < numScalars; j++)
+        {
+        vtkArrayCalculatorGather(&blocks, blocks.Scalars[j], i, 1, value);
+        this->FunctionParser->SetScalarVariableValue(j, value[0]);
+        }
+      for (j = 0; j < numVectors; j++)
+        {
+        for (int comp = 0; comp < 3; comp++)
+          {
+          vtkArrayCalculatorGather(&blocks, blocks.Vectors[3*j+comp], i, 1,
+                                   value+comp);
+          }
+        this->FunctionParser->SetVectorVariableValue(j, value);
+        }
+      if (resultType == 0)
+        {
+        scalarResult[0] = this->FunctionParser->GetScalarResult();
+        resultArray->SetTuple(i, scalarResult);
+        }
+      else
+        {
+        resultArray->SetTuple(i, this->FunctionParser->GetVectorResult());
+        }
       }
     }
   
@@ -1220,4 +1471,5 @@ void vtkArrayCalculator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Replace Invalid Values: " 
      << (this->ReplaceInvalidValues ? "On" : "Off") << endl;
   os << indent << "Replacement Value: " << this->ReplacementValue << endl;
+  os << indent << "Number Of Threads: " << this->NumberOfThreads << endl;
 }
@@ -51,6 +51,8 @@
 // both (e.g., you can multiply a scalar times a vector). The operations are performed
 // tuple-wise (i.e., tuple-by-tuple). The user must specify which arrays to use as
 // vectors and/or scalars, and the name of the output data array.
+// The tuples are evaluated in blocks, optionally by several threads (see
+// NumberOfThreads).
 //
 // .SECTION See Also
 // vtkFunctionParser
@@ -200,6 +202,15 @@ public:
   vtkSetMacro(ReplacementValue,double);
   vtkGetMacro(ReplacementValue,double);
 
+  // Description:
+  // Set/Get the number of threads evaluating the function. The tuples are
+  // evaluated in blocks (see vtkFunctionParser::EvaluateBlock()) which are
+  // shared among the threads. Coordinate variables of datasets that are not
+  // point sets, or of graphs, and bit arrays are only read by one thread.
+  // Initial value is 1.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_LARGE_INTEGER);
+  vtkGetMacro(NumberOfThreads, int);
+
 protected:
   vtkArrayCalculator();
   ~vtkArrayCalculator();
@@ -231,6 +242,7 @@ protected:
   int NumberOfCoordinateVectorArrays;
 
   int ResultArrayType;
+  int NumberOfThreads;
 
 private:
   vtkArrayCalculator(const vtkArrayCalculator&);  // Not implemented.
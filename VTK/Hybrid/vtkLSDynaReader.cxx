@@ -81,6 +81,7 @@ typedef FILE* vtkLSDynaFile_t;
 #include <vtkstd/algorithm>
 #include <vtkstd/map>
 
+#include <vtkCellArray.h>
 #include <vtkCellData.h>
 #include <vtkCellType.h>
 #include <vtkDataObject.h>
@@ -90,6 +91,7 @@ typedef FILE* vtkLSDynaFile_t;
 #include <vtkFloatArray.h>
 #include <vtkPoints.h>
 #include <vtkPointData.h>
+#include <vtkSmartPointer.h>
 #include <vtkInformation.h>
 #include <vtkInformationDoubleVectorKey.h>
 #include <vtkInformationVector.h>
@@ -99,6 +101,7 @@ typedef FILE* vtkLSDynaFile_t;
 #include <vtkStreamingDemandDrivenPipeline.h>
 #include <vtkSystemIncludes.h>
 #include <vtkThreshold.h>
+#include <vtkUnsignedCharArray.h>
 #include <vtkUnstructuredGrid.h>
 #include <vtkXMLParser.h>
 
@@ -1159,6 +1162,14 @@ public:
   // Number of bytes required to store a single timestep
   vtkIdType StateSize;
 
+  // Cells and material (or segment) ID arrays of each cell type as read by
+  // ReadConnectivityAndMaterial(). The connectivity does not change from one
+  // state to the next, so they are reused for the states of the same
+  // adaptation level as long as the same ID arrays are requested.
+  vtkSmartPointer<vtkUnstructuredGrid> CachedTopology[vtkLSDynaReader::NUM_CELL_TYPES];
+  int CachedTopologyAdaptLevel;
+  vtkstd::vector<int> CachedTopologyArrayStatus;
+
   vtkLSDynaReaderPrivate()
     {
     this->FileIsValid = 0;
@@ -1171,6 +1182,7 @@ public:
     this->PreStateSize = 0;
     this->StateSize = 0;
     this->CurrentState = 0;
+    this->CachedTopologyAdaptLevel = -1;
 
     vtkstd::vector<vtkstd::string> blankNames;
     vtkstd::vector<int> blankNumbers;
@@ -1274,6 +1286,18 @@ public:
 
     this->RigidSurfaceSegmentSizes.clear();
     this->TimeValues.clear();
+
+    this->ClearCachedTopology();
+    }
+
+  void ClearCachedTopology()
+    {
+    for ( int cellType = 0; cellType < vtkLSDynaReader::NUM_CELL_TYPES; ++cellType )
+      {
+      this->CachedTopology[cellType] = 0;
+      }
+    this->CachedTopologyAdaptLevel = -1;
+    this->CachedTopologyArrayStatus.clear();
     }
 
   /// Dump the dictionary of Dyna keywords and their values.
@@ -2454,6 +2478,9 @@ int vtkLSDynaReader::ReadHeaderInformation( int curAdapt )
 {
   vtkLSDynaReaderPrivate* p = this->P;
 
+  // Materials and cell counts are about to change.
+  p->ClearCachedTopology();
+
   // =================================== Control Word Section
   p->Fam.SkipToWord( vtkLSDynaFamily::ControlSection, curAdapt /*timestep*/, 0 );
   p->Fam.BufferChunk( vtkLSDynaFamily::Char, 10 );
@@ -3498,6 +3525,41 @@ int vtkLSDynaReader::ReadConnectivityAndMaterial()
     return 1;
     }
 
+  vtkUnstructuredGrid* outputs[vtkLSDynaReader::NUM_CELL_TYPES];
+  outputs[vtkLSDynaReader::PARTICLE] = this->OutputParticles;
+  outputs[vtkLSDynaReader::BEAM] = this->OutputBeams;
+  outputs[vtkLSDynaReader::SHELL] = this->OutputShell;
+  outputs[vtkLSDynaReader::THICK_SHELL] = this->OutputThickShell;
+  outputs[vtkLSDynaReader::SOLID] = this->OutputSolid;
+  outputs[vtkLSDynaReader::RIGID_BODY] = this->OutputRigidBody;
+  outputs[vtkLSDynaReader::ROAD_SURFACE] = this->OutputRoadSurface;
+
+  vtkstd::vector<int> arrayStatus;
+  int ct;
+  for ( ct = 0; ct < vtkLSDynaReader::NUM_CELL_TYPES; ++ct )
+    {
+    arrayStatus.push_back( this->GetCellArrayStatus( ct, LS_ARRAYNAME_MATERIAL ) );
+    }
+  arrayStatus.push_back( this->GetCellArrayStatus( vtkLSDynaReader::ROAD_SURFACE, LS_ARRAYNAME_SEGMENTID ) );
+
+  // Reuse the cells read for a previous state.
+  if ( p->CachedTopologyAdaptLevel == p->Fam.GetCurrentAdaptLevel() &&
+       p->CachedTopologyArrayStatus == arrayStatus )
+    {
+    for ( ct = 0; ct < vtkLSDynaReader::NUM_CELL_TYPES; ++ct )
+      {
+      vtkUnstructuredGrid* cached = p->CachedTopology[ct];
+      outputs[ct]->SetCells( cached->GetCellTypesArray(),
+        cached->GetCellLocationsArray(), cached->GetCells() );
+      vtkCellData* cd = cached->GetCellData();
+      for ( int a = 0; a < cd->GetNumberOfArrays(); ++a )
+        {
+        outputs[ct]->GetCellData()->AddArray( cd->GetArray( a ) );
+        }
+      }
+    return 0;
+    }
+
   vtkIdType nc;
   vtkIntArray* matl = 0;
   vtkIdType conn[8];
@@ -3735,6 +3797,27 @@ int vtkLSDynaReader::ReadConnectivityAndMaterial()
       }
     }
 
+  // Keep the cells and ID arrays for the following states.
+  for ( ct = 0; ct < vtkLSDynaReader::NUM_CELL_TYPES; ++ct )
+    {
+    vtkUnstructuredGrid* cached = vtkUnstructuredGrid::New();
+    cached->SetCells( outputs[ct]->GetCellTypesArray(),
+      outputs[ct]->GetCellLocationsArray(), outputs[ct]->GetCells() );
+    vtkCellData* cd = outputs[ct]->GetCellData();
+    const char* names[] = { LS_ARRAYNAME_MATERIAL, LS_ARRAYNAME_SEGMENTID };
+    for ( int a = 0; a < 2; ++a )
+      {
+      if ( cd->GetArray( names[a] ) )
+        {
+        cached->GetCellData()->AddArray( cd->GetArray( names[a] ) );
+        }
+      }
+    p->CachedTopology[ct] = cached;
+    cached->Delete();
+    }
+  p->CachedTopologyAdaptLevel = p->Fam.GetCurrentAdaptLevel();
+  p->CachedTopologyArrayStatus = arrayStatus;
+
   return 0;
 }
 
@@ -30,7 +30,9 @@
 
 #include <sys/stat.h>
 #include <ctype.h>
+#include <vtkstd/map>
 #include <vtkstd/string>
+#include <vtkstd/vector>
 
 vtkCxxRevisionMacro(vtkEnSightGoldBinaryReader, "$Revision$");
 vtkStandardNewMacro(vtkEnSightGoldBinaryReader);
@@ -38,10 +40,41 @@ vtkStandardNewMacro(vtkEnSightGoldBinaryReader);
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+// Size of the buffer of the input file stream. Most reads are 80 character
+// lines and single integers.
+#define VTK_ENSIGHT_GOLD_BINARY_BUFFER_SIZE (256*1024)
+
+//----------------------------------------------------------------------------
+// Offsets of the "BEGIN TIME STEP" lines of the files read so far, so that
+// a time step of a file set is reached with a single seek instead of
+// scanning all the time steps before it. The offsets of a file are dropped
+// when its size or modification time changes.
+class vtkEnSightGoldBinaryReader::FileOffsetMapInternal
+{
+public:
+  struct FileOffsets
+  {
+    FileOffsets() : Size(-1), MTime(0), NumberOfTimeSteps(-1) {}
+    vtkTypeInt64 Size;
+    long MTime;
+    int NumberOfTimeSteps;
+    vtkstd::map<int, vtkTypeInt64> TimeSteps;
+  };
+
+  FileOffsetMapInternal() : Current(NULL) {}
+
+  vtkstd::map<vtkstd::string, FileOffsets> Map;
+  // Offsets of the file currently open.
+  FileOffsets *Current;
+  // Buffer of the input file stream.
+  vtkstd::vector<char> Buffer;
+};
+
 //----------------------------------------------------------------------------
 vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
 {
   this->IFile = NULL;
+  this->FileOffsets = new FileOffsetMapInternal;
   this->FileSize = 0;
   this->Fortran = 0;
   this->NodeIdsListed = 0;
@@ -57,6 +90,7 @@ vtkEnSightGoldBinaryReader::~vtkEnSightGoldBinaryReader()
     delete this->IFile;
     this->IFile = NULL;
     }
+  delete this->FileOffsets;
 }
 
 //----------------------------------------------------------------------------
@@ -84,10 +118,26 @@ int vtkEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (int)(fs.st_size);
 
+    FileOffsetMapInternal::FileOffsets &offsets =
+      this->FileOffsets->Map[filename];
+    if (offsets.Size != static_cast<vtkTypeInt64>(fs.st_size) ||
+        offsets.MTime != static_cast<long>(fs.st_mtime))
+      {
+      offsets = FileOffsetMapInternal::FileOffsets();
+      offsets.Size = static_cast<vtkTypeInt64>(fs.st_size);
+      offsets.MTime = static_cast<long>(fs.st_mtime);
+      }
+    this->FileOffsets->Current = &offsets;
+
+    // The buffer has to be set before the file is opened.
+    this->FileOffsets->Buffer.resize(VTK_ENSIGHT_GOLD_BINARY_BUFFER_SIZE);
+    this->IFile = new ifstream;
+    this->IFile->rdbuf()->pubsetbuf(&this->FileOffsets->Buffer[0],
+      VTK_ENSIGHT_GOLD_BINARY_BUFFER_SIZE);
 #ifdef _WIN32
-    this->IFile = new ifstream(filename, ios::in | ios::binary);
+    this->IFile->open(filename, ios::in | ios::binary);
 #else
-    this->IFile = new ifstream(filename, ios::in);
+    this->IFile->open(filename, ios::in);
 #endif
     }
   else
@@ -187,24 +237,24 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
 
   if (this->UseFileSets)
     {
+    int timeStepInFile = 0;
     if (numberOfTimeStepsInFile>1)
       {
-      for (i = 0; i < timeStep - 1; i++)
+      timeStepInFile = timeStep - 1;
+      for (i = this->SeekToCachedTimeStep(timeStepInFile);
+           i < timeStepInFile; i++)
         {
-        if (!this->SkipTimeStep())
+        if (!this->SkipTimeStep(i))
           {
           return 0;
           }
         }
       }
       
-    // use do-while here to initialize 'line' before 'strncmp' is appllied
-    // Thanks go to Brancois for care of this issue
-    do
+    if (!this->ReadTimeStepBegin(timeStepInFile, line))
       {
-      this->ReadLine(line);
+      return 0;
       }
-    while ( strncmp(line, "BEGIN TIME STEP", 15) != 0 );
     }
   
   // Skip the 2 description lines.
@@ -345,10 +395,16 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
 //----------------------------------------------------------------------------
 int vtkEnSightGoldBinaryReader::CountTimeSteps()
 {
+  FileOffsetMapInternal::FileOffsets *offsets = this->FileOffsets->Current;
+  if (offsets && offsets->NumberOfTimeSteps >= 0)
+    {
+    return offsets->NumberOfTimeSteps;
+    }
+
   int count=0;
   while(1)
     {
-    int result=this->SkipTimeStep();
+    int result=this->SkipTimeStep(count);
     if (result)
       {
       count++;
@@ -358,22 +414,22 @@ int vtkEnSightGoldBinaryReader::CountTimeSteps()
       break;
       }
     }
+  if (offsets)
+    {
+    offsets->NumberOfTimeSteps = count;
+    }
   return count;
 }
 
 //----------------------------------------------------------------------------
-int vtkEnSightGoldBinaryReader::SkipTimeStep()
+int vtkEnSightGoldBinaryReader::SkipTimeStep(int timeStep)
 {
   char line[80], subLine[80];
   int lineRead;
 
-  line[0] = '\0';
-  while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+  if (!this->ReadTimeStepBegin(timeStep, line))
     {
-    if (!this->ReadLine(line))
-      {
-      return 0;
-      }
+    return 0;
     }
   
   // Skip the 2 description lines.
@@ -1095,11 +1151,11 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+      if (!this->ReadTimeStepBegin(i, line))
         {
-        this->ReadLine(line);
+        return 0;
         }
       // Skip the description line.
       this->ReadLine(line);
@@ -1121,9 +1177,9 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
                ios::cur);      
       this->ReadLine(line); // END TIME STEP
       }
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+    if (!this->ReadTimeStepBegin(timeStep - 1, line))
       {
-      this->ReadLine(line);
+      return 0;
       }
     }
   
@@ -1151,13 +1207,20 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   this->ReadIntArray( pointIds, this->NumberOfMeasuredPoints );
   
   // Read point coordinates tuple by tuple while each tuple contains three
-  // components: (x-cord, y-cord, z-cord)
-  int  floatSize = sizeof( float );
-  for ( i = 0; i < this->NumberOfMeasuredPoints; i ++ )
-    {
-    this->IFile->read(  ( char * )( xCoords + i ),  floatSize  );
-    this->IFile->read(  ( char * )( yCoords + i ),  floatSize  );
-    this->IFile->read(  ( char * )( zCoords + i ),  floatSize  );
+  // components: (x-cord, y-cord, z-cord). They are read at once and then
+  // split into the three arrays.
+  if ( this->NumberOfMeasuredPoints > 0 )
+    {
+    float *coords = new float [ 3 * this->NumberOfMeasuredPoints ];
+    this->IFile->read( ( char * ) coords,
+                       3 * this->NumberOfMeasuredPoints * sizeof( float ) );
+    for ( i = 0; i < this->NumberOfMeasuredPoints; i ++ )
+      {
+      xCoords[i] = coords[3 * i];
+      yCoords[i] = coords[3 * i + 1];
+      zCoords[i] = coords[3 * i + 2];
+      }
+    delete [] coords;
     }
    
   if ( this->ByteOrder == FILE_LITTLE_ENDIAN )
@@ -1245,12 +1308,11 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+      if (!this->ReadTimeStepBegin(i, line))
         {
-        this->ReadLine(line);
+        return 0;
         }
       this->ReadLine(line); // skip the description line
       
@@ -1284,10 +1346,9 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
           }
         }
       }
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+    if (!this->ReadTimeStepBegin(timeStep - 1, line))
       {
-      this->ReadLine(line);
+      return 0;
       }
     }
   
@@ -1446,12 +1507,11 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+      if (!this->ReadTimeStepBegin(i, line))
         {
-        this->ReadLine(line);
+        return 0;
         }
       this->ReadLine(line); // skip the description line
       
@@ -1485,10 +1545,9 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
           }
         }
       }
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+    if (!this->ReadTimeStepBegin(timeStep - 1, line))
       {
-      this->ReadLine(line);
+      return 0;
       }
     }
   
@@ -1627,12 +1686,11 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+      if (!this->ReadTimeStepBegin(i, line))
         {
-        this->ReadLine(line);
+        return 0;
         }
       this->ReadLine(line); // skip the description line
       
@@ -1652,10 +1710,9 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
           }
         }
       }
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+    if (!this->ReadTimeStepBegin(timeStep - 1, line))
       {
-      this->ReadLine(line);
+      return 0;
       }
     }
   
@@ -1772,12 +1829,11 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
   
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+      if (!this->ReadTimeStepBegin(i, line))
         {
-        this->ReadLine(line);
+        return 0;
         }
       this->ReadLine(line); // skip the description line
       lineRead = this->ReadLine(line); // "part"
@@ -1833,10 +1889,9 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
           }
         } // end while
       } // end for
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+    if (!this->ReadTimeStepBegin(timeStep - 1, line))
       {
-      this->ReadLine(line);
+      return 0;
       }
     }
   
@@ -2010,12 +2065,11 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+      if (!this->ReadTimeStepBegin(i, line))
         {
-        this->ReadLine(line);
+        return 0;
         }
       this->ReadLine(line); // skip the description line
       lineRead = this->ReadLine(line); // "part"
@@ -2068,10 +2122,9 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
           }
         }
       }
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+    if (!this->ReadTimeStepBegin(timeStep - 1, line))
       {
-      this->ReadLine(line);
+      return 0;
       }
     }
   
@@ -2242,12 +2295,11 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+      if (!this->ReadTimeStepBegin(i, line))
         {
-        this->ReadLine(line);
+        return 0;
         }
       this->ReadLine(line); // skip the description line
       lineRead = this->ReadLine(line); // "part"
@@ -2300,10 +2352,9 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
           }
         }
       }
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+    if (!this->ReadTimeStepBegin(timeStep - 1, line))
       {
-      this->ReadLine(line);
+      return 0;
       }
     }
   
@@ -3800,6 +3851,50 @@ int vtkEnSightGoldBinaryReader::CreateImageDataOutput(
   return lineRead;
 }
 
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::ReadTimeStepBegin(int timeStep,
+                                                  char line[80])
+{
+  vtkTypeInt64 offset;
+  do
+    {
+    offset = static_cast<vtkTypeInt64>(this->IFile->tellg());
+    if (!this->ReadLine(line))
+      {
+      vtkDebugMacro("BEGIN TIME STEP not found for time step " << timeStep);
+      return 0;
+      }
+    }
+  while (strncmp(line, "BEGIN TIME STEP", 15) != 0);
+
+  if (this->FileOffsets->Current && offset >= 0)
+    {
+    this->FileOffsets->Current->TimeSteps[timeStep] = offset;
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::SeekToCachedTimeStep(int timeStep)
+{
+  if (!this->FileOffsets->Current || timeStep <= 0)
+    {
+    return 0;
+    }
+  vtkstd::map<int, vtkTypeInt64> &timeSteps =
+    this->FileOffsets->Current->TimeSteps;
+  // the last cached time step not after timeStep
+  vtkstd::map<int, vtkTypeInt64>::iterator it =
+    timeSteps.upper_bound(timeStep);
+  if (it == timeSteps.begin())
+    {
+    return 0;
+    }
+  --it;
+  this->IFile->seekg(static_cast<long>(it->second), ios::beg);
+  return it->first;
+}
+
 // Internal function to read in a line up to 80 characters.
 // Returns zero if there was an error.
 int vtkEnSightGoldBinaryReader::ReadLine(char result[80])
@@ -172,12 +172,25 @@ protected:
   int CountTimeSteps();
 
   // Description:
-  // Read to the next time step in the geometry file.
-  int SkipTimeStep();
+  // Read to the next time step in the geometry file. \a timeStep is the
+  // index of the time step in the file, used to cache its offset.
+  int SkipTimeStep(int timeStep);
   int SkipStructuredGrid(char line[256]);
   int SkipUnstructuredGrid(char line[256]);
   int SkipRectilinearGrid(char line[256]);
   int SkipImageData(char line[256]);
+
+  // Description:
+  // Read lines up to and including the next "BEGIN TIME STEP" line and
+  // remember its offset as that of time step \a timeStep (0 based) of the
+  // current file. Returns zero if the end of the file was reached.
+  int ReadTimeStepBegin(int timeStep, char line[80]);
+
+  // Description:
+  // Move to the "BEGIN TIME STEP" line of the last time step up to
+  // \a timeStep whose offset in the current file is known. Returns the
+  // index of that time step, or 0 if the file was left where it was.
+  int SeekToCachedTimeStep(int timeStep);
   
   int NodeIdsListed;
   int ElementIdsListed;
@@ -187,6 +200,11 @@ protected:
   // The size of the file could be used to choose byte order.
   int FileSize;
 
+//BTX
+  class FileOffsetMapInternal;
+  FileOffsetMapInternal *FileOffsets;
+//ETX
+
 private:
   vtkEnSightGoldBinaryReader(const vtkEnSightGoldBinaryReader&);  // Not implemented.
   void operator=(const vtkEnSightGoldBinaryReader&);  // Not implemented.
@@ -41,6 +41,10 @@
 #define VTK_FOAMFILE_OUTBUFSIZE (131072)
 #define VTK_FOAMFILE_INCLUDE_STACK_SIZE (10)
 
+// The number of double precision values converted at a time when reading
+// binary scalar/vector lists into float arrays.
+#define VTK_FOAMFILE_BINARY_BLOCKSIZE (16384)
+
 #if defined(_MSC_VER) && (_MSC_VER >= 1400)
 #define _CRT_SECURE_NO_WARNINGS 1
 #endif
@@ -1917,6 +1921,35 @@ VTK_TEMPLATE_SPECIALIZE inline float vtkFoamReadValue<float>::ReadValue(vtkFoamI
   return io.ReadFloatValue();
 }
 
+// reads a binary list of double precision values into floats. the values
+// are read in large blocks and converted in a tight loop rather than being
+// read one at a time.
+static void vtkFoamReadBinaryDoubles(vtkFoamIOobject& io, float *values,
+    const int nValues)
+{
+  const int blockSize = nValues < VTK_FOAMFILE_BINARY_BLOCKSIZE ? nValues
+      : VTK_FOAMFILE_BINARY_BLOCKSIZE;
+  // not allocated on the stack because of the size, but in a vector to
+  // avoid leak when an exception is thrown.
+  vtkstd::vector<double> buffer(blockSize);
+  for (int valueI = 0; valueI < nValues; valueI += blockSize)
+    {
+    const int nRead = nValues - valueI < blockSize ? nValues - valueI
+        : blockSize;
+    const int nBytes = static_cast<int>(nRead * sizeof(double));
+    if (io.Read(reinterpret_cast<unsigned char *>(&buffer[0]), nBytes)
+        != nBytes)
+      {
+      throw vtkFoamError() << "Unexpected EOF";
+      }
+    float *valuesI = values + valueI;
+    for (int i = 0; i < nRead; i++)
+      {
+      valuesI[i] = static_cast<float>(buffer[i]);
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // class vtkFoamEntryValue
 // a class that represents a value of a dictionary entry that corresponds to
@@ -2064,13 +2097,8 @@ public:
         }
       else
         {
-        for (int i = 0; i < size; i++)
-          {
-          double buffer[nComponents];
-          io.Read(reinterpret_cast<unsigned char *>(buffer), sizeof(double)
-              * nComponents);
-          this->Ptr->SetTuple(i, buffer);
-          }
+        vtkFoamReadBinaryDoubles(io, this->Ptr->GetPointer(0),
+            size * nComponents);
         }
     }
     void ReadValue(vtkFoamIOobject& io, vtkFoamToken& currToken)
@@ -2252,8 +2280,12 @@ public:
             }
           if (bodyI + sizeJ > this->Superclass::LabelListListPtr->GetBodySize())
             {
-            const int newSize =
-                this->Superclass::LabelListListPtr->GetBodySize() + sizeJ;
+            // grow geometrically so that meshes with many faces larger
+            // than the initial guess don't reallocate the body per face
+            const int bodySize =
+                this->Superclass::LabelListListPtr->GetBodySize();
+            const int newSize = bodyI + sizeJ > 2 * bodySize ? bodyI + sizeJ
+                : 2 * bodySize;
             this->Superclass::LabelListListPtr->ResizeBody(newSize);
             }
           int *listI = this->Superclass::LabelListListPtr->SetIndex(i, bodyI);
@@ -2291,7 +2323,7 @@ public:
             if (bodyI >= this->LabelListListPtr->GetBodySize())
               {
               const int newSize =
-                  this->Superclass::LabelListListPtr->GetBodySize() + 1;
+                  2 * this->Superclass::LabelListListPtr->GetBodySize() + 1;
               this->Superclass::LabelListListPtr->ResizeBody(newSize);
               }
             this->Superclass::LabelListListPtr
@@ -2376,12 +2408,7 @@ VTK_TEMPLATE_SPECIALIZE
 void vtkFoamEntryValue::listTraits<vtkFloatArray, float>::ReadBinaryList(
     vtkFoamIOobject& io, const int size)
 {
-  for (int i = 0; i < size; i++)
-    {
-    double buffer;
-    io.Read(reinterpret_cast<unsigned char *>(&buffer), sizeof(double));
-    this->Ptr->SetValue(i, static_cast<float>(buffer));
-    }
+  vtkFoamReadBinaryDoubles(io, this->Ptr->GetPointer(0), size);
 }
 
 // generic reader for nonuniform lists. requires size prefix of the
@@ -4571,20 +4598,24 @@ vtkFoamIntVectorVector * vtkOpenFOAMReaderPrivate::ReadOwnerNeighborFiles(
       return NULL;
       }
 
+    // raw pointers since these loops run over all the faces several times
+    const int *faceOwnerPtr = faceOwner.GetPointer(0);
+    const int *faceNeighborPtr = faceNeighbor.GetPointer(0);
+
     // add the face numbers to the correct cell cf. Terry's code and
     // src/OpenFOAM/meshes/primitiveMesh/primitiveMeshCells.C
     // find the number of cells
     int nCells = -1;
     for (int faceI = 0; faceI < nNeiFaces; faceI++)
       {
-      const int ownerCell = faceOwner.GetValue(faceI);
+      const int ownerCell = faceOwnerPtr[faceI];
       if (nCells < ownerCell) // max(nCells, faceOwner[i])
         {
         nCells = ownerCell;
         }
       // we do need to take neighbor faces into account since all the
       // surrounding faces of a cell can be neighbors for a valid mesh
-      const int neighborCell = faceNeighbor.GetValue(faceI);
+      const int neighborCell = faceNeighborPtr[faceI];
       if (nCells < neighborCell) // max(nCells, faceNeighbor[i])
         {
         nCells = neighborCell;
@@ -4592,7 +4623,7 @@ vtkFoamIntVectorVector * vtkOpenFOAMReaderPrivate::ReadOwnerNeighborFiles(
       }
     for (int faceI = nNeiFaces; faceI < nFaces; faceI++)
       {
-      const int ownerCell = faceOwner.GetValue(faceI);
+      const int ownerCell = faceOwnerPtr[faceI];
       if (nCells < ownerCell) // max(nCells, faceOwner[i])
         {
         nCells = ownerCell;
@@ -4621,14 +4652,14 @@ vtkFoamIntVectorVector * vtkOpenFOAMReaderPrivate::ReadOwnerNeighborFiles(
     cfiPtr++; // offset +1
     for (int faceI = 0; faceI < nNeiFaces; faceI++)
       {
-      const int ownerCell = faceOwner.GetValue(faceI);
+      const int ownerCell = faceOwnerPtr[faceI];
       // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
       if (ownerCell >= 0)
         {
         cfiPtr[ownerCell]++;
         nTotalCellFaces++;
         }
-      const int neighborCell=faceNeighbor.GetValue(faceI);
+      const int neighborCell=faceNeighborPtr[faceI];
       if (neighborCell >= 0)
         {
         cfiPtr[neighborCell]++;
@@ -4637,7 +4668,7 @@ vtkFoamIntVectorVector * vtkOpenFOAMReaderPrivate::ReadOwnerNeighborFiles(
       }
     for (int faceI = nNeiFaces; faceI < nFaces; faceI++)
       {
-      const int ownerCell = faceOwner.GetValue(faceI);
+      const int ownerCell = faceOwnerPtr[faceI];
       if (ownerCell >= 0)
         {
         cfiPtr[ownerCell]++;
@@ -4662,28 +4693,28 @@ vtkFoamIntVectorVector * vtkOpenFOAMReaderPrivate::ReadOwnerNeighborFiles(
       }
 
     // add face numbers to cell-faces list
-    vtkIntArray *cellFacesList = cells->GetBody();
+    int *cellFacesList = cells->GetBody()->GetPointer(0);
     for (int faceI = 0; faceI < nNeiFaces; faceI++)
       {
-      const int ownerCell = faceOwner.GetValue(faceI); // must be a signed int
+      const int ownerCell = faceOwnerPtr[faceI]; // must be a signed int
       // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
       if (ownerCell >= 0)
         {
-        cellFacesList->SetValue(tfiPtr[ownerCell]++, faceI);
+        cellFacesList[tfiPtr[ownerCell]++] = faceI;
         }
-      const int neighborCell = faceNeighbor.GetValue(faceI);
+      const int neighborCell = faceNeighborPtr[faceI];
       if (neighborCell >= 0)
         {
-        cellFacesList->SetValue(tfiPtr[neighborCell]++, faceI);
+        cellFacesList[tfiPtr[neighborCell]++] = faceI;
         }
       }
     for (int faceI = nNeiFaces; faceI < nFaces; faceI++)
       {
-      const int ownerCell = faceOwner.GetValue(faceI); // must be a signed int
+      const int ownerCell = faceOwnerPtr[faceI]; // must be a signed int
       // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
       if (ownerCell >= 0)
         {
-        cellFacesList->SetValue(tfiPtr[ownerCell]++, faceI);
+        cellFacesList[tfiPtr[ownerCell]++] = faceI;
         }
       }
     tmpFaceIndices->Delete();
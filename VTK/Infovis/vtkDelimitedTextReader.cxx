@@ -357,24 +357,6 @@ private:
   vtkUnicodeString::value_type WithinString;
 };
 
-/////////////////////////////////////////////////////////////////////////////////////////
-// ascii_to_unicode
-
-template<typename OctetIteratorT, typename OutputIteratorT>
-void ascii_to_unicode(OctetIteratorT begin, OctetIteratorT end, OutputIteratorT output)
-{
-  while(begin != end)
-    {
-    const vtkTypeUInt32 code_point = *begin++;
-    if(code_point > 0x7f)
-      throw vtkstd::runtime_error("Not an ASCII character");
-
-    *output++ = code_point;
-    }
-
-   output.ReachedEndOfInput();
-}
-
 /////////////////////////////////////////////////////////////////////////////////////////
 // utf16_to_unicode
 
@@ -615,59 +597,83 @@ int vtkDelimitedTextReader::RequestData(
     const vtkIdType total_bytes = file_stream.tellg();
     file_stream.seekg(0, ios::beg);
 
-    // Read the file into a buffer ...
-    vtkstd::vector<unsigned char> content(total_bytes);
-    file_stream.read(reinterpret_cast<char*>(&content[0]), total_bytes);
-
-    DelimitedTextIterator iterator(
-      this->MaxRecords,
-      this->UnicodeRecordDelimiters,
-      this->UnicodeFieldDelimiters,
-      this->UnicodeStringDelimiters,
-      this->UnicodeWhitespace,
-      this->UnicodeEscapeCharacter,
-      this->HaveHeaders,
-      this->UnicodeOutputArrays,
-      this->MergeConsecutiveDelimiters,
-      this->UseStringDelimiter,
-      output_table);
-
-    if("US-ASCII" == character_set)
-      {
-      ascii_to_unicode(content.begin(), content.end(), iterator);
-      }
-    else if("UTF-8" == character_set)
-      {
-      iterator = vtk_utf8::utf8to32(content.begin(),  content.end(), iterator);
-      iterator.ReachedEndOfInput();
-      }
-    else if("UTF-16" == character_set)
-      {
-      if(content.size() > 1 && static_cast<unsigned char>(content[0]) == 0xfe && static_cast<unsigned char>(content[1]) == 0xff)
-        {
-        utf16_to_unicode(true, content.begin() + 2, content.end(), iterator);
-        }
-      else if(content.size() > 1 && static_cast<unsigned char>(content[0]) == 0xff && static_cast<unsigned char>(content[1]) == 0xfe)
+    // The iterator pads the columns to the same length when it goes out
+    // of scope, which must happen before the table is post-processed ...
+    {
+      DelimitedTextIterator iterator(
+        this->MaxRecords,
+        this->UnicodeRecordDelimiters,
+        this->UnicodeFieldDelimiters,
+        this->UnicodeStringDelimiters,
+        this->UnicodeWhitespace,
+        this->UnicodeEscapeCharacter,
+        this->HaveHeaders,
+        this->UnicodeOutputArrays,
+        this->MergeConsecutiveDelimiters,
+        this->UseStringDelimiter,
+        output_table);
+
+      // ASCII files are parsed one block at a time so that the whole file is
+      // never held in memory next to the table being built ...
+      if("US-ASCII" == character_set)
         {
-        utf16_to_unicode(false, content.begin() + 2, content.end(), iterator);
+        const vtkIdType block_size = 1 << 20;
+        vtkstd::vector<char> block(
+          static_cast<size_t>(total_bytes < block_size ? total_bytes : block_size) + 1);
+        while(file_stream.good())
+          {
+          file_stream.read(&block[0], block.size());
+          const vtkIdType count = file_stream.gcount();
+          for(vtkIdType i = 0; i != count; ++i)
+            {
+            const vtkTypeUInt32 code_point = static_cast<unsigned char>(block[i]);
+            if(code_point > 0x7f)
+              throw vtkstd::runtime_error("Not an ASCII character");
+            iterator = code_point;
+            }
+          }
+        iterator.ReachedEndOfInput();
         }
       else
         {
-        throw vtkstd::runtime_error("Cannot detect the endianness of UTF-16 data.  Use 'UTF-16BE' or 'UTF-16LE' instead.");
+        // Read the file into a buffer ...
+        vtkstd::vector<unsigned char> content(total_bytes);
+        file_stream.read(reinterpret_cast<char*>(&content[0]), total_bytes);
+
+        if("UTF-8" == character_set)
+          {
+          iterator = vtk_utf8::utf8to32(content.begin(),  content.end(), iterator);
+          iterator.ReachedEndOfInput();
+          }
+        else if("UTF-16" == character_set)
+          {
+          if(content.size() > 1 && static_cast<unsigned char>(content[0]) == 0xfe && static_cast<unsigned char>(content[1]) == 0xff)
+            {
+            utf16_to_unicode(true, content.begin() + 2, content.end(), iterator);
+            }
+          else if(content.size() > 1 && static_cast<unsigned char>(content[0]) == 0xff && static_cast<unsigned char>(content[1]) == 0xfe)
+            {
+            utf16_to_unicode(false, content.begin() + 2, content.end(), iterator);
+            }
+          else
+            {
+            throw vtkstd::runtime_error("Cannot detect the endianness of UTF-16 data.  Use 'UTF-16BE' or 'UTF-16LE' instead.");
+            }
+          }
+        else if("UTF-16BE" == character_set)
+          {
+          utf16_to_unicode(true, content.begin(), content.end(), iterator);
+          }
+        else if("UTF-16LE" == character_set)
+          {
+          utf16_to_unicode(false, content.begin(), content.end(), iterator);
+          }
+        else
+          {
+          throw vtkstd::runtime_error("Unknown UnicodeCharacterSet: " + vtkStdString(this->UnicodeCharacterSet));
+          }
         }
-      }
-    else if("UTF-16BE" == character_set)
-      {
-      utf16_to_unicode(true, content.begin(), content.end(), iterator);
-      }
-    else if("UTF-16LE" == character_set)
-      {
-      utf16_to_unicode(false, content.begin(), content.end(), iterator);
-      }
-    else
-      {
-      throw vtkstd::runtime_error("Unknown UnicodeCharacterSet: " + vtkStdString(this->UnicodeCharacterSet));
-      }
+    }
 
     if(this->OutputPedigreeIds)
       {
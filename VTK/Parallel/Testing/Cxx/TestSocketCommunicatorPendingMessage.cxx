@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSocketCommunicatorPendingMessage.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests vtkSocketCommunicator::HasPendingMessage() with a message queued
+// behind more data than a single peek at the socket returns.
+
+#include "vtkClientSocket.h"
+#include "vtkServerSocket.h"
+#include "vtkSmartPointer.h"
+#include "vtkSocketCommunicator.h"
+
+#include <vtksys/SystemTools.hxx>
+#include <vtkstd/vector>
+
+#define VTK_CREATE(type, name) \
+  vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
+
+static const int DATA_TAG = 1234;
+static const int PENDING_TAG = 5678;
+static const int DATA_LENGTH = 20000;
+
+// Retries for a while since the data sent may take some time to arrive.
+static int WaitForPendingMessage(vtkSocketCommunicator* comm, int tag)
+{
+  for (int i = 0; i < 100; i++)
+    {
+    if (comm->HasPendingMessage(tag))
+      {
+      return 1;
+      }
+    vtksys::SystemTools::Delay(10);
+    }
+  return 0;
+}
+
+int TestSocketCommunicatorPendingMessage(int, char*[])
+{
+  VTK_CREATE(vtkServerSocket, server);
+  if (server->CreateServer(0) != 0)
+    {
+    cerr << "Failed to create the server socket." << endl;
+    return 1;
+    }
+  VTK_CREATE(vtkClientSocket, clientSocket);
+  if (clientSocket->ConnectToServer("localhost", server->GetServerPort()) != 0)
+    {
+    cerr << "Failed to connect to the server socket." << endl;
+    return 1;
+    }
+  vtkSmartPointer<vtkClientSocket> serverSocket;
+  serverSocket.TakeReference(server->WaitForConnection(1000));
+  if (!serverSocket)
+    {
+    cerr << "Failed to accept the connection." << endl;
+    return 1;
+    }
+
+  VTK_CREATE(vtkSocketCommunicator, sender);
+  sender->SetSocket(clientSocket);
+  VTK_CREATE(vtkSocketCommunicator, receiver);
+  receiver->SetSocket(serverSocket);
+
+  if (receiver->HasPendingMessage(PENDING_TAG))
+    {
+    cerr << "Found a message before anything was sent." << endl;
+    return 1;
+    }
+
+  // Two messages in front of the one looked for, larger together than what
+  // is peeked at first.
+  vtkstd::vector<char> data(DATA_LENGTH);
+  for (int i = 0; i < DATA_LENGTH; i++)
+    {
+    data[i] = static_cast<char>(i % 127);
+    }
+  sender->Send(&data[0], DATA_LENGTH, 1, DATA_TAG);
+  sender->Send(&data[0], DATA_LENGTH, 1, DATA_TAG);
+  if (WaitForPendingMessage(receiver, PENDING_TAG))
+    {
+    cerr << "Found a message that was not sent." << endl;
+    return 1;
+    }
+
+  int value = 42;
+  sender->Send(&value, 1, 1, PENDING_TAG);
+  if (!WaitForPendingMessage(receiver, PENDING_TAG))
+    {
+    cerr << "Message queued behind " << 2*DATA_LENGTH
+         << " bytes was not found." << endl;
+    return 1;
+    }
+
+  // Nothing was taken off the socket.
+  for (int m = 0; m < 2; m++)
+    {
+    vtkstd::vector<char> received(DATA_LENGTH);
+    if (!receiver->Receive(&received[0], DATA_LENGTH, 1, DATA_TAG) ||
+      received != data)
+      {
+      cerr << "Failed to receive the data messages." << endl;
+      return 1;
+      }
+    }
+  int receivedValue = 0;
+  if (!receiver->Receive(&receivedValue, 1, 1, PENDING_TAG) ||
+    receivedValue != value)
+    {
+    cerr << "Failed to receive the pending message." << endl;
+    return 1;
+    }
+  if (receiver->HasPendingMessage(PENDING_TAG))
+    {
+    cerr << "Found a message that was already received." << endl;
+    return 1;
+    }
+
+  return 0;
+}
@@ -34,6 +34,11 @@
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
+#include "vtk_zlib.h"
+
+#include <vtksys/SystemTools.hxx>
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
 
 vtkCxxRevisionMacro(vtkPOpenFOAMReader, "$Revision$");
 vtkStandardNewMacro(vtkPOpenFOAMReader);
@@ -55,6 +60,7 @@ vtkPOpenFOAMReader::vtkPOpenFOAMReader()
     this->ProcessId = this->Controller->GetLocalProcessId();
     }
   this->CaseType = RECONSTRUCTED_CASE;
+  this->LoadBalancing = 0;
   this->MTimeOld = 0;
   this->MaximumNumberOfPieces = 1;
 }
@@ -70,6 +76,7 @@ void vtkPOpenFOAMReader::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Case Type: " << this->CaseType << endl;
+  os << indent << "Load Balancing: " << this->LoadBalancing << endl;
   os << indent << "MTimeOld: " << this->MTimeOld << endl;
   os << indent << "Maximum Number of Pieces: " << this->MaximumNumberOfPieces
       << endl;
@@ -261,11 +268,34 @@ int vtkPOpenFOAMReader::RequestInformation(vtkInformation *request,
 
     this->MaximumNumberOfPieces = procNames->GetNumberOfTuples();
 
+    // decide which process reads which processor subdirectory
+    vtkIntArray *procAssignment = vtkIntArray::New();
+    if (this->LoadBalancing && this->NumProcesses > 1)
+      {
+      if (this->ProcessId == 0)
+        {
+        this->AssignProcessorDirectories(masterCasePath, procNames,
+            procAssignment);
+        }
+      this->Controller->Broadcast(procAssignment, 0);
+      }
+    else
+      {
+      procAssignment->SetNumberOfValues(procNames->GetNumberOfTuples());
+      for (int procI = 0; procI < procNames->GetNumberOfTuples(); procI++)
+        {
+        procAssignment->SetValue(procI, procI % this->NumProcesses);
+        }
+      }
+
     // create reader instances for other processor subdirectories
     // skip processor0 since it's already created
-    for (int procI = (this->ProcessId ? this->ProcessId : this->NumProcesses); procI
-        < procNames->GetNumberOfTuples(); procI += this->NumProcesses)
+    for (int procI = 1; procI < procNames->GetNumberOfTuples(); procI++)
       {
+      if (procAssignment->GetValue(procI) != this->ProcessId)
+        {
+        continue;
+        }
       vtkOpenFOAMReader *subReader = vtkOpenFOAMReader::New();
       subReader->SetFileName(this->FileName);
       subReader->SetParent(this);
@@ -283,6 +313,7 @@ int vtkPOpenFOAMReader::RequestInformation(vtkInformation *request,
       subReader->Delete();
       }
 
+    procAssignment->Delete();
     procNames->Delete();
 
     this->GatherMetaData();
@@ -390,6 +421,130 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
   return ret;
 }
 
+//-----------------------------------------------------------------------------
+// Returns an estimate of the number of cells of a processor subdirectory.
+// OpenFOAM writes "nCells: N" to the note entry of the owner file header;
+// if that is not available the size of the owner file is returned, with
+// isCellCount set to false.
+static double vtkPOpenFOAMReaderEstimateLoad(const vtkStdString &polyMeshPath,
+    bool &isCellCount)
+{
+  isCellCount = false;
+  const vtkStdString ownerPaths[2] =
+    { polyMeshPath + "owner", polyMeshPath + "owner.gz" };
+  for (int pathI = 0; pathI < 2; pathI++)
+    {
+    const vtkStdString &ownerPath = ownerPaths[pathI];
+    if (!vtksys::SystemTools::FileExists(ownerPath.c_str(), true))
+      {
+      continue;
+      }
+    // gzread() reads uncompressed files as well. The header is at most a
+    // few hundred bytes long.
+    gzFile file = gzopen(ownerPath.c_str(), "rb");
+    if (file)
+      {
+      char header[4097];
+      const int len = gzread(file, header, 4096);
+      gzclose(file);
+      if (len > 0)
+        {
+        header[len] = '\0';
+        const char *nCellsStr = strstr(header, "nCells:");
+        if (nCellsStr)
+          {
+          char *conversionEnd;
+          const long nCells = strtol(nCellsStr + 7, &conversionEnd, 10);
+          if (conversionEnd != nCellsStr + 7 && nCells >= 0)
+            {
+            isCellCount = true;
+            return static_cast<double>(nCells);
+            }
+          }
+        }
+      }
+    return static_cast<double>(
+      vtksys::SystemTools::FileLength(ownerPath.c_str()));
+    }
+  return 0.0;
+}
+
+//-----------------------------------------------------------------------------
+// Assign processor subdirectories to processes so that the loads are
+// balanced: the subdirectories are assigned in decreasing order of their
+// loads, each one to the least loaded process at that time (LPT scheduling).
+// processor0 always goes to process 0 whose reader instance provides the
+// metadata.
+void vtkPOpenFOAMReader::AssignProcessorDirectories(
+    const vtkStdString &casePath, vtkStringArray *procNames,
+    vtkIntArray *procAssignment)
+{
+  const int nProcDirs = procNames->GetNumberOfTuples();
+  procAssignment->SetNumberOfValues(nProcDirs);
+  if (nProcDirs == 0)
+    {
+    return;
+    }
+
+  vtkstd::vector<double> cellCounts(nProcDirs), fileSizes(nProcDirs);
+  bool allCellCounts = true;
+  for (int procI = 0; procI < nProcDirs; procI++)
+    {
+    bool isCellCount;
+    const double load = vtkPOpenFOAMReaderEstimateLoad(casePath
+        + procNames->GetValue(procI) + "/constant/polyMesh/", isCellCount);
+    if (isCellCount)
+      {
+      cellCounts[procI] = load;
+      }
+    else
+      {
+      fileSizes[procI] = load;
+      allCellCounts = false;
+      }
+    }
+  // don't mix cell counts and file sizes
+  if (!allCellCounts)
+    {
+    for (int procI = 0; procI < nProcDirs; procI++)
+      {
+      if (fileSizes[procI] == 0.0)
+        {
+        fileSizes[procI] = static_cast<double>(
+          vtksys::SystemTools::FileLength((casePath + procNames->GetValue(procI)
+          + "/constant/polyMesh/owner").c_str()));
+        }
+      }
+    }
+  const vtkstd::vector<double> &loads = allCellCounts ? cellCounts : fileSizes;
+
+  vtkstd::vector<vtkstd::pair<double, int> > order;
+  for (int procI = 1; procI < nProcDirs; procI++)
+    {
+    // negated for decreasing loads, ties in the processor order
+    order.push_back(vtkstd::pair<double, int>(-loads[procI], procI));
+    }
+  vtkstd::sort(order.begin(), order.end());
+
+  vtkstd::vector<double> processLoads(this->NumProcesses, 0.0);
+  procAssignment->SetValue(0, 0);
+  processLoads[0] = loads[0];
+  for (size_t orderI = 0; orderI < order.size(); orderI++)
+    {
+    int minProcess = 0;
+    for (int processI = 1; processI < this->NumProcesses; processI++)
+      {
+      if (processLoads[processI] < processLoads[minProcess])
+        {
+        minProcess = processI;
+        }
+      }
+    const int procI = order[orderI].second;
+    procAssignment->SetValue(procI, minProcess);
+    processLoads[minProcess] += loads[procI];
+    }
+}
+
 //-----------------------------------------------------------------------------
 void vtkPOpenFOAMReader::BroadcastStatus(int &status)
 {
@@ -30,6 +30,9 @@
 #include "vtkOpenFOAMReader.h"
 
 class vtkDataArraySelection;
+class vtkIntArray;
+class vtkStdString;
+class vtkStringArray;
 class vtkMultiProcessController;
 
 class VTK_PARALLEL_EXPORT vtkPOpenFOAMReader : public vtkOpenFOAMReader
@@ -47,6 +50,17 @@ public:
   // Set and get case type. 0 = decomposed case, 1 = reconstructed case.
   void SetCaseType(const int t);
   vtkGetMacro(CaseType, caseType);
+
+  // Description:
+  // When set, processor subdirectories of a decomposed case are assigned
+  // to processes so that the numbers of cells are balanced, instead of in
+  // a round-robin fashion. The number of cells of each subdirectory is
+  // taken from the header of its owner file (or the file size when the
+  // header doesn't tell). Off by default.
+  vtkSetMacro(LoadBalancing, int);
+  vtkGetMacro(LoadBalancing, int);
+  vtkBooleanMacro(LoadBalancing, int);
+
   // Description:
   // Set and get the controller.
   virtual void SetController(vtkMultiProcessController *);
@@ -64,6 +78,7 @@ protected:
 private:
   vtkMultiProcessController *Controller;
   caseType CaseType;
+  int LoadBalancing;
   unsigned long MTimeOld;
   int MaximumNumberOfPieces;
   int NumProcesses;
@@ -73,6 +88,8 @@ private:
   void operator=(const vtkPOpenFOAMReader &); // Not implemented.
 
   void GatherMetaData();
+  void AssignProcessorDirectories(const vtkStdString &, vtkStringArray *,
+    vtkIntArray *);
   void BroadcastStatus(int &);
   void Broadcast(vtkStringArray *);
   void AllGather(vtkStringArray *);
@@ -705,6 +705,57 @@ int vtkSocketCommunicator::ConnectTo ( char* hostName, int port )
   return this->ClientSideHandshake();
 }
 
+//----------------------------------------------------------------------------
+int vtkSocketCommunicator::HasPendingMessage(int tag)
+{
+  if (!this->Socket)
+    {
+    return 0;
+    }
+
+  // Walk the headers (tag, length) of the messages already on the socket,
+  // skipping over their data. Only the start of the pending data can be
+  // peeked at, so the buffer grows until it holds the next header or all
+  // the data that has arrived.
+  const int headerSize = static_cast<int>(2*sizeof(int));
+  vtkstd::vector<char> buffer(16384);
+  int size = this->Socket->Peek(&buffer[0], static_cast<int>(buffer.size()));
+  int offset = 0;
+  for (;;)
+    {
+    if (offset > size - headerSize)
+      {
+      if (size < static_cast<int>(buffer.size()) ||
+        buffer.size() > static_cast<size_t>(VTK_INT_MAX / 2))
+        {
+        // The next header has not arrived yet.
+        return 0;
+        }
+      buffer.resize(2*buffer.size());
+      size = this->Socket->Peek(&buffer[0], static_cast<int>(buffer.size()));
+      continue;
+      }
+    int recvTag;
+    int length;
+    memcpy(&recvTag, &buffer[offset], sizeof(int));
+    memcpy(&length, &buffer[offset + sizeof(int)], sizeof(int));
+    if (this->SwapBytesInReceivedData == vtkSocketCommunicator::SwapOn)
+      {
+      vtkSwap4(reinterpret_cast<char*>(&recvTag));
+      vtkSwap4(reinterpret_cast<char*>(&length));
+      }
+    if (recvTag == tag)
+      {
+      return 1;
+      }
+    if (length < 0 || length > VTK_INT_MAX - headerSize - offset)
+      {
+      return 0;
+      }
+    offset += headerSize + length;
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkSocketCommunicator::SendTagged(const void* data, int wordSize,
                                       int numWords, int tag,
@@ -168,6 +168,13 @@ public:
   vtkGetObjectMacro(Socket, vtkClientSocket);
   void SetSocket(vtkClientSocket*);
 
+  // Description:
+  // Returns 1 if a message with the given tag has already arrived on the
+  // socket, possibly behind other messages that are not received yet.
+  // Nothing is removed from the socket and the call does not block. The
+  // messages in front of it are skipped using their lengths.
+  int HasPendingMessage(int tag);
+
   // Description:
   // Performs handshake. This uses vtkClientSocket::ConnectingSide to decide
   // whether to perform ServerSideHandshake or ClientSideHandshake. 
@@ -0,0 +1,349 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkXMLPAggregatedUnstructuredDataWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkXMLPAggregatedUnstructuredDataWriter.h"
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommunicator.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLPolyDataWriter.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <vtkstd/vector>
+
+//----------------------------------------------------------------------------
+// Source producing the pieces gathered by an aggregator, piece i for an
+// update request of piece i. The writer of the aggregated file streams
+// through the pieces with it.
+class vtkXMLPAggregatedPieceSource : public vtkAlgorithm
+{
+public:
+  static vtkXMLPAggregatedPieceSource* New();
+  vtkTypeRevisionMacro(vtkXMLPAggregatedPieceSource, vtkAlgorithm);
+
+  vtkstd::vector<vtkSmartPointer<vtkDataObject> > Pieces;
+
+  int ProcessRequest(vtkInformation* request,
+                     vtkInformationVector** inputVector,
+                     vtkInformationVector* outputVector)
+    {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+      {
+      vtkDataObject* output = this->Pieces[0]->NewInstance();
+      output->SetPipelineInformation(outInfo);
+      output->Delete();
+      return 1;
+      }
+    if (request->Has(vtkDemandDrivenPipeline::REQUEST_INFORMATION()))
+      {
+      outInfo->Set(
+        vtkStreamingDemandDrivenPipeline::MAXIMUM_NUMBER_OF_PIECES(), -1);
+      return 1;
+      }
+    if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+      {
+      vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+      int piece = outInfo->Get(
+        vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+      if (piece >= 0 && piece < static_cast<int>(this->Pieces.size()))
+        {
+        output->ShallowCopy(this->Pieces[piece]);
+        }
+      else
+        {
+        output->Initialize();
+        }
+      return 1;
+      }
+    return this->Superclass::ProcessRequest(request, inputVector,
+                                            outputVector);
+    }
+
+protected:
+  vtkXMLPAggregatedPieceSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->SetNumberOfOutputPorts(1);
+    }
+
+  virtual int FillOutputPortInformation(int, vtkInformation* info)
+    {
+    info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkPointSet");
+    return 1;
+    }
+
+private:
+  vtkXMLPAggregatedPieceSource(const vtkXMLPAggregatedPieceSource&); // Not implemented.
+  void operator=(const vtkXMLPAggregatedPieceSource&); // Not implemented.
+};
+
+vtkStandardNewMacro(vtkXMLPAggregatedPieceSource);
+vtkCxxRevisionMacro(vtkXMLPAggregatedPieceSource, "$Revision$");
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkXMLPAggregatedUnstructuredDataWriter);
+vtkCxxRevisionMacro(vtkXMLPAggregatedUnstructuredDataWriter, "$Revision$");
+vtkCxxSetObjectMacro(vtkXMLPAggregatedUnstructuredDataWriter,
+                     Controller,
+                     vtkMultiProcessController);
+
+//----------------------------------------------------------------------------
+vtkXMLPAggregatedUnstructuredDataWriter::vtkXMLPAggregatedUnstructuredDataWriter()
+{
+  this->NumberOfAggregators = 0;
+  this->Controller = 0;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//----------------------------------------------------------------------------
+vtkXMLPAggregatedUnstructuredDataWriter::~vtkXMLPAggregatedUnstructuredDataWriter()
+{
+  this->SetController(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLPAggregatedUnstructuredDataWriter::PrintSelf(ostream& os,
+                                                        vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "NumberOfAggregators: " << this->NumberOfAggregators
+     << "\n";
+  os << indent << "Controller: ";
+  if (this->Controller)
+    {
+    this->Controller->PrintSelf(os, indent.GetNextIndent());
+    }
+  else
+    {
+    os << "(none)\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+const char* vtkXMLPAggregatedUnstructuredDataWriter::GetDataSetName()
+{
+  if (vtkPolyData::SafeDownCast(this->GetInput()))
+    {
+    return "PPolyData";
+    }
+  return "PUnstructuredGrid";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkXMLPAggregatedUnstructuredDataWriter::GetDefaultFileExtension()
+{
+  if (vtkPolyData::SafeDownCast(this->GetInput()))
+    {
+    return "pvtp";
+    }
+  return "pvtu";
+}
+
+//----------------------------------------------------------------------------
+vtkXMLUnstructuredDataWriter*
+vtkXMLPAggregatedUnstructuredDataWriter::CreateUnstructuredPieceWriter()
+{
+  // Create the writer for the piece.
+  if (vtkPolyData::SafeDownCast(this->GetInput()))
+    {
+    vtkXMLPolyDataWriter* pWriter = vtkXMLPolyDataWriter::New();
+    pWriter->SetInput(this->GetInput());
+    return pWriter;
+    }
+  vtkXMLUnstructuredGridWriter* pWriter = vtkXMLUnstructuredGridWriter::New();
+  pWriter->SetInput(this->GetInput());
+  return pWriter;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLPAggregatedUnstructuredDataWriter::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLPAggregatedUnstructuredDataWriter::WriteInternal()
+{
+  int numProcs = 1;
+  int myId = 0;
+  if (this->Controller)
+    {
+    numProcs = this->Controller->GetNumberOfProcesses();
+    myId = this->Controller->GetLocalProcessId();
+    }
+  int numGroups = this->NumberOfAggregators < numProcs?
+    this->NumberOfAggregators : numProcs;
+  if (numGroups <= 0)
+    {
+    return this->Superclass::WriteInternal();
+    }
+  if (this->NumberOfPieces != numProcs || this->StartPiece != myId ||
+      this->EndPiece != myId)
+    {
+    vtkWarningMacro("Aggregation requires one piece per process. "
+                    "Writing one file per piece instead.");
+    return this->Superclass::WriteInternal();
+    }
+
+  // Prepare the file names.
+  this->SplitFileName();
+  if (!this->PieceFileNameExtension)
+    {
+    vtkXMLWriter* pWriter = this->CreateUnstructuredPieceWriter();
+    const char* ext = pWriter->GetDefaultFileExtension();
+    this->PieceFileNameExtension = new char[strlen(ext)+2];
+    this->PieceFileNameExtension[0] = '.';
+    strcpy(this->PieceFileNameExtension+1, ext);
+    pWriter->Delete();
+    }
+
+  // Group i has the processes [i*numProcs/numGroups,
+  // (i+1)*numProcs/numGroups).
+  int group = 0;
+  while (myId >= (group + 1) * numProcs / numGroups)
+    {
+    group++;
+    }
+  int aggregator = group * numProcs / numGroups;
+
+  int result;
+  if (myId != aggregator)
+    {
+    result = this->Controller->Send(this->GetInput(), aggregator,
+      vtkXMLPAggregatedUnstructuredDataWriter::PIECE_TAG);
+    }
+  else
+    {
+    result = this->WriteAggregatedPieces(group,
+      (group + 1) * numProcs / numGroups);
+    }
+
+  // Only write the summary file if all the files were written.
+  int allResult = 0;
+  this->Controller->AllReduce(&result, &allResult, 1,
+                              vtkCommunicator::MIN_OP);
+  if (!allResult)
+    {
+    if (myId == aggregator && result)
+      {
+      char* fileName = this->CreatePieceFileName(group, this->PathName);
+      this->DeleteAFile(fileName);
+      delete [] fileName;
+      }
+    return 0;
+    }
+
+  // Decide whether to write the summary file.
+  int writeSummary = 0;
+  if(this->WriteSummaryFileInitialized)
+    {
+    writeSummary = this->WriteSummaryFile;
+    }
+  else if(myId == 0)
+    {
+    writeSummary = 1;
+    }
+
+  if (writeSummary)
+    {
+    // The summary file refers to one file per group.
+    int numberOfPieces = this->NumberOfPieces;
+    this->NumberOfPieces = numGroups;
+    result = this->vtkXMLWriter::WriteInternal();
+    this->NumberOfPieces = numberOfPieces;
+    if (!result)
+      {
+      vtkErrorMacro("Ran out of disk space; deleting file(s) already written");
+      if (myId == aggregator)
+        {
+        char* fileName = this->CreatePieceFileName(group, this->PathName);
+        this->DeleteAFile(fileName);
+        delete [] fileName;
+        }
+      return 0;
+      }
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLPAggregatedUnstructuredDataWriter::WriteAggregatedPieces(
+  int group, int endProcess)
+{
+  vtkDataObject* input = this->GetInput();
+  int myId = this->Controller->GetLocalProcessId();
+
+  // Collect the pieces of the group, the local one first.
+  vtkSmartPointer<vtkXMLPAggregatedPieceSource> source =
+    vtkSmartPointer<vtkXMLPAggregatedPieceSource>::New();
+  vtkSmartPointer<vtkDataObject> localPiece;
+  localPiece.TakeReference(input->NewInstance());
+  localPiece->ShallowCopy(input);
+  source->Pieces.push_back(localPiece);
+  int result = 1;
+  for (int procId = myId + 1; procId < endProcess; ++procId)
+    {
+    vtkSmartPointer<vtkDataObject> piece;
+    piece.TakeReference(input->NewInstance());
+    if (!this->Controller->Receive(piece, procId,
+          vtkXMLPAggregatedUnstructuredDataWriter::PIECE_TAG))
+      {
+      vtkErrorMacro("Failed to receive the piece of process " << procId);
+      result = 0;
+      }
+    source->Pieces.push_back(piece);
+    }
+  if (!result)
+    {
+    return 0;
+    }
+
+  // Write all the pieces to one file. The writer requests them one after
+  // the other from the source.
+  vtkXMLUnstructuredDataWriter* pWriter = this->CreateUnstructuredPieceWriter();
+  pWriter->SetInputConnection(source->GetOutputPort());
+  pWriter->SetNumberOfPieces(static_cast<int>(source->Pieces.size()));
+  pWriter->SetGhostLevel(this->GhostLevel);
+  pWriter->AddObserver(vtkCommand::ProgressEvent, this->ProgressObserver);
+
+  char* fileName = this->CreatePieceFileName(group, this->PathName);
+  pWriter->SetFileName(fileName);
+  delete [] fileName;
+
+  // Copy the writer settings.
+  pWriter->SetCompressor(this->Compressor);
+  pWriter->SetDataMode(this->DataMode);
+  pWriter->SetByteOrder(this->ByteOrder);
+  pWriter->SetEncodeAppendedData(this->EncodeAppendedData);
+
+  result = pWriter->Write();
+  this->SetErrorCode(pWriter->GetErrorCode());
+
+  pWriter->RemoveObserver(this->ProgressObserver);
+  pWriter->Delete();
+
+  return result;
+}
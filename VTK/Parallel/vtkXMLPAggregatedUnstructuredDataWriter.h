@@ -0,0 +1,100 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkXMLPAggregatedUnstructuredDataWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkXMLPAggregatedUnstructuredDataWriter - Write PVTU/PVTP files
+// with fewer piece files than processes.
+// .SECTION Description
+// vtkXMLPAggregatedUnstructuredDataWriter writes vtkUnstructuredGrid or
+// vtkPolyData inputs like vtkXMLPUnstructuredGridWriter and
+// vtkXMLPPolyDataWriter do. When NumberOfAggregators is set, the processes
+// are split into that many groups of consecutive ranks instead of writing
+// one file each. Every process sends its piece to the first process of its
+// group (the aggregator), which writes all the pieces of the group to a
+// single VTU/VTP file, one Piece element each. The summary file then
+// references one file per group. The XML readers read such files as they
+// are.
+//
+// Aggregation requires one piece per process, i.e. NumberOfPieces equal to
+// the number of processes of the controller and StartPiece == EndPiece ==
+// the local process id. Otherwise, or when NumberOfAggregators is 0 (the
+// default), one file per piece is written.
+// .SECTION See Also
+// vtkXMLPUnstructuredGridWriter vtkXMLPPolyDataWriter
+
+#ifndef __vtkXMLPAggregatedUnstructuredDataWriter_h
+#define __vtkXMLPAggregatedUnstructuredDataWriter_h
+
+#include "vtkXMLPUnstructuredDataWriter.h"
+
+class vtkMultiProcessController;
+
+class VTK_PARALLEL_EXPORT vtkXMLPAggregatedUnstructuredDataWriter :
+  public vtkXMLPUnstructuredDataWriter
+{
+public:
+  static vtkXMLPAggregatedUnstructuredDataWriter* New();
+  vtkTypeRevisionMacro(vtkXMLPAggregatedUnstructuredDataWriter,
+                       vtkXMLPUnstructuredDataWriter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get/Set the number of files written, each by the first process of a
+  // group of processes. 0 (the default) writes one file per piece. The
+  // value is limited to the number of processes.
+  vtkSetClampMacro(NumberOfAggregators, int, 0, VTK_LARGE_INTEGER);
+  vtkGetMacro(NumberOfAggregators, int);
+
+  // Description:
+  // Controller used to send the pieces to the aggregators.
+  // By default, the global controller is used.
+  virtual void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+
+  // Description:
+  // Get the default file extension for files written by this writer,
+  // which depends on the type of the input.
+  const char* GetDefaultFileExtension();
+
+//BTX
+protected:
+  vtkXMLPAggregatedUnstructuredDataWriter();
+  ~vtkXMLPAggregatedUnstructuredDataWriter();
+
+  virtual int WriteInternal();
+
+  // Receives the pieces of the processes up to endProcess (excluded) of
+  // the group whose first process is this one, and writes them.
+  int WriteAggregatedPieces(int group, int endProcess);
+
+  const char* GetDataSetName();
+  vtkXMLUnstructuredDataWriter* CreateUnstructuredPieceWriter();
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+
+  int NumberOfAggregators;
+  vtkMultiProcessController* Controller;
+
+  enum
+  {
+    PIECE_TAG = 14290
+  };
+
+private:
+  vtkXMLPAggregatedUnstructuredDataWriter(
+    const vtkXMLPAggregatedUnstructuredDataWriter&); // Not implemented.
+  void operator=(
+    const vtkXMLPAggregatedUnstructuredDataWriter&); // Not implemented.
+//ETX
+};
+
+#endif
@@ -15,6 +15,7 @@
 #include "vtkUnstructuredGridVolumeRayCastMapper.h"
 
 #include "vtkCamera.h"
+#include "vtkCriticalSection.h"
 #include "vtkEncodedGradientEstimator.h"
 #include "vtkEncodedGradientShader.h"
 #include "vtkFiniteDifferenceGradientEstimator.h"
@@ -65,6 +66,12 @@ vtkUnstructuredGridVolumeRayCastMapper::vtkUnstructuredGridVolumeRayCastMapper()
   this->Threader               = vtkMultiThreader::New();
   this->NumberOfThreads        = this->Threader->GetNumberOfThreads();
 
+  this->TileLock               = vtkCriticalSection::New();
+  this->ImageTileSize          = 16;
+  this->NumberOfTiles[0]       = 0;
+  this->NumberOfTiles[1]       = 0;
+  this->NextTile               = 0;
+
   this->Image                  = NULL;
 
   this->RenderTimeTable        = NULL;
@@ -92,6 +99,7 @@ vtkUnstructuredGridVolumeRayCastMapper::vtkUnstructuredGridVolumeRayCastMapper()
 vtkUnstructuredGridVolumeRayCastMapper::~vtkUnstructuredGridVolumeRayCastMapper()
 {
   this->Threader->Delete();
+  this->TileLock->Delete();
   
   if ( this->Image )
     {
@@ -440,6 +448,14 @@ void vtkUnstructuredGridVolumeRayCastMapper::Render( vtkRenderer *ren, vtkVolume
       }
     }
 
+  // Split the in-use image into tiles that the threads pull from
+  // dynamically.
+  this->NumberOfTiles[0] =
+    (this->ImageInUseSize[0] + this->ImageTileSize - 1) / this->ImageTileSize;
+  this->NumberOfTiles[1] =
+    (this->ImageInUseSize[1] + this->ImageTileSize - 1) / this->ImageTileSize;
+  this->NextTile = 0;
+
   // Set the number of threads to use for ray casting,
   // then set the execution method and do it.
   this->Threader->SetNumberOfThreads( this->NumberOfThreads );
@@ -544,7 +560,20 @@ inline void vtkUGVRCMLookupCopy(const T *src, T *dest, vtkIdType *lookup,
     }
 }
 
-void vtkUnstructuredGridVolumeRayCastMapper::CastRays( int threadID, int threadCount )
+int vtkUnstructuredGridVolumeRayCastMapper::GetNextTile()
+{
+  int tile = -1;
+  this->TileLock->Lock();
+  if ( this->NextTile < this->NumberOfTiles[0]*this->NumberOfTiles[1] )
+    {
+    tile = this->NextTile++;
+    }
+  this->TileLock->Unlock();
+  return tile;
+}
+
+void vtkUnstructuredGridVolumeRayCastMapper::CastRays( int threadID,
+                                                       int vtkNotUsed(threadCount) )
 {
   int i, j;
   unsigned char *ucptr;
@@ -558,16 +587,13 @@ void vtkUnstructuredGridVolumeRayCastMapper::CastRays( int threadID, int threadC
   vtkDataArray *nearIntersections = this->NearIntersectionsBuffer[threadID];
   vtkDataArray *farIntersections = this->FarIntersectionsBuffer[threadID];
 
-  for ( j = 0; j < this->ImageInUseSize[1]; j++ )
+  int totalTiles = this->NumberOfTiles[0]*this->NumberOfTiles[1];
+  int tile;
+  while ( (tile = this->GetNextTile()) >= 0 )
     {
-    if ( j%threadCount != threadID )
-      {
-      continue;
-      }
-
     if ( !threadID )
       {
-      this->UpdateProgress((double)j/this->ImageInUseSize[1]);
+      this->UpdateProgress(static_cast<double>(tile)/totalTiles);
       if ( renWin->CheckAbortStatus() )
         {
         break;
@@ -577,93 +603,106 @@ void vtkUnstructuredGridVolumeRayCastMapper::CastRays( int threadID, int threadC
       {
       break;
       }
-    
-    ucptr = this->Image + 4*j*this->ImageMemorySize[0];
 
-    for ( i = 0; i < this->ImageInUseSize[0]; i++ )
+    int tileMin[2], tileMax[2];
+    tileMin[0] = (tile % this->NumberOfTiles[0]) * this->ImageTileSize;
+    tileMin[1] = (tile / this->NumberOfTiles[0]) * this->ImageTileSize;
+    tileMax[0] = tileMin[0] + this->ImageTileSize;
+    tileMax[1] = tileMin[1] + this->ImageTileSize;
+    tileMax[0] = (tileMax[0] > this->ImageInUseSize[0]) ?
+      (this->ImageInUseSize[0]) : (tileMax[0]);
+    tileMax[1] = (tileMax[1] > this->ImageInUseSize[1]) ?
+      (this->ImageInUseSize[1]) : (tileMax[1]);
+
+    for ( j = tileMin[1]; j < tileMax[1]; j++ )
       {
-      int x = i + this->ImageOrigin[0];
-      int y = j + this->ImageOrigin[1];
-      
-      double bounds[2] = {0.0,1.0};
-      float color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-      
-      if ( this->ZBuffer )
+      ucptr = this->Image + 4*(j*this->ImageMemorySize[0] + tileMin[0]);
+
+      for ( i = tileMin[0]; i < tileMax[0]; i++ )
         {
-        bounds[1] = this->GetZBufferValue( x, y );
-        }
+        int x = i + this->ImageOrigin[0];
+        int y = j + this->ImageOrigin[1];
 
-      iterator->SetBounds(bounds);
-      iterator->Initialize(x, y);
+        double bounds[2] = {0.0,1.0};
+        float color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
 
-      vtkIdType numIntersections;
-      do
-        {
-        if (this->CellScalars)
+        if ( this->ZBuffer )
           {
-          numIntersections = iterator->GetNextIntersections(intersectedCells,
-                                                            intersectionLengths,
-                                                            NULL,
-                                                            NULL, NULL);
-          nearIntersections
-            ->SetNumberOfComponents(this->Scalars->GetNumberOfComponents());
-          nearIntersections->SetNumberOfTuples(numIntersections);
-          switch (this->Scalars->GetDataType())
+          bounds[1] = this->GetZBufferValue( x, y );
+          }
+
+        iterator->SetBounds(bounds);
+        iterator->Initialize(x, y);
+
+        vtkIdType numIntersections;
+        do
+          {
+          if (this->CellScalars)
             {
-            vtkTemplateMacro(vtkUGVRCMLookupCopy
-                             ((const VTK_TT*)this->Scalars->GetVoidPointer(0),
-                              (VTK_TT*)nearIntersections->GetVoidPointer(0),
-                              intersectedCells->GetPointer(0),
-                              this->Scalars->GetNumberOfComponents(),
-                              numIntersections));
+            numIntersections = iterator->GetNextIntersections(intersectedCells,
+                                                              intersectionLengths,
+                                                              NULL,
+                                                              NULL, NULL);
+            nearIntersections
+              ->SetNumberOfComponents(this->Scalars->GetNumberOfComponents());
+            nearIntersections->SetNumberOfTuples(numIntersections);
+            switch (this->Scalars->GetDataType())
+              {
+              vtkTemplateMacro(vtkUGVRCMLookupCopy
+                               ((const VTK_TT*)this->Scalars->GetVoidPointer(0),
+                                (VTK_TT*)nearIntersections->GetVoidPointer(0),
+                                intersectedCells->GetPointer(0),
+                                this->Scalars->GetNumberOfComponents(),
+                                numIntersections));
+              }
             }
-          }
-        else
+          else
+            {
+            numIntersections = iterator->GetNextIntersections(NULL,
+                                                              intersectionLengths,
+                                                              this->Scalars,
+                                                              nearIntersections,
+                                                              farIntersections);
+            }
+          if (numIntersections < 1) break;
+          this->RealRayIntegrator->Integrate(intersectionLengths,
+                                             nearIntersections,
+                                             farIntersections,
+                                             color);
+          } while (color[3] < 0.99);
+
+        if ( color[3] > 0.0 )
           {
-          numIntersections = iterator->GetNextIntersections(NULL,
-                                                            intersectionLengths,
-                                                            this->Scalars,
-                                                            nearIntersections,
-                                                            farIntersections);
-          }
-        if (numIntersections < 1) break;
-        this->RealRayIntegrator->Integrate(intersectionLengths,
-                                           nearIntersections,
-                                           farIntersections,
-                                           color);
-        } while (color[3] < 0.99);
-
-      if ( color[3] > 0.0 )
-        {
-        int val;
-        val = static_cast<int>(color[0]*255.0);
-        val = (val > 255)?(255):(val);
-        val = (val <   0)?(  0):(val);
-        ucptr[0] = static_cast<unsigned char>(val);
+          int val;
+          val = static_cast<int>(color[0]*255.0);
+          val = (val > 255)?(255):(val);
+          val = (val <   0)?(  0):(val);
+          ucptr[0] = static_cast<unsigned char>(val);
         
-        val = static_cast<int>(color[1]*255.0);
-        val = (val > 255)?(255):(val);
-        val = (val <   0)?(  0):(val);
-        ucptr[1] = static_cast<unsigned char>(val);
+          val = static_cast<int>(color[1]*255.0);
+          val = (val > 255)?(255):(val);
+          val = (val <   0)?(  0):(val);
+          ucptr[1] = static_cast<unsigned char>(val);
         
-        val = static_cast<int>(color[2]*255.0);
-        val = (val > 255)?(255):(val);
-        val = (val <   0)?(  0):(val);
-        ucptr[2] = static_cast<unsigned char>(val);
+          val = static_cast<int>(color[2]*255.0);
+          val = (val > 255)?(255):(val);
+          val = (val <   0)?(  0):(val);
+          ucptr[2] = static_cast<unsigned char>(val);
         
-        val = static_cast<int>(color[3]*255.0);
-        val = (val > 255)?(255):(val);
-        val = (val <   0)?(  0):(val);
-        ucptr[3] = static_cast<unsigned char>(val);
-        }
-      else
-        {
-        ucptr[0] = 0;
-        ucptr[1] = 0;
-        ucptr[2] = 0;
-        ucptr[3] = 0;
+          val = static_cast<int>(color[3]*255.0);
+          val = (val > 255)?(255):(val);
+          val = (val <   0)?(  0):(val);
+          ucptr[3] = static_cast<unsigned char>(val);
+          }
+        else
+          {
+          ucptr[0] = 0;
+          ucptr[1] = 0;
+          ucptr[2] = 0;
+          ucptr[3] = 0;
+          }
+        ucptr+=4;
         }
-      ucptr+=4;
       }
     }
 }
@@ -747,6 +786,7 @@ void vtkUnstructuredGridVolumeRayCastMapper::PrintSelf(ostream& os, vtkIndent in
     << (this->IntermixIntersectingGeometry ? "On\n" : "Off\n");
   
   os << indent << "Number Of Threads: " << this->NumberOfThreads << "\n";
+  os << indent << "Image Tile Size: " << this->ImageTileSize << "\n";
   
   if (this->RayCastFunction)
     {
@@ -25,6 +25,7 @@
 
 #include "vtkUnstructuredGridVolumeMapper.h"
 
+class vtkCriticalSection;
 class vtkDoubleArray;
 class vtkIdList;
 class vtkMultiThreader;
@@ -77,6 +78,14 @@ public:
   vtkSetMacro( NumberOfThreads, int );
   vtkGetMacro( NumberOfThreads, int );
 
+  // Description:
+  // Set/Get the edge length, in image pixels, of the square tiles the image
+  // is split into for ray casting. Threads grab tiles from a shared counter
+  // as they finish their previous one, so regions with deep rays do not
+  // stall the other threads. Default is 16.
+  vtkSetClampMacro( ImageTileSize, int, 1, 1024 );
+  vtkGetMacro( ImageTileSize, int );
+
   // Description:
   // If IntermixIntersectingGeometry is turned on, the zbuffer will be
   // captured and used to limit the traversal of the rays.
@@ -128,6 +137,17 @@ protected:
   vtkMultiThreader  *Threader;
   int               NumberOfThreads;
 
+  // Tiles of the in-use image handed out to the ray casting threads.
+  // NextTile is only touched while holding TileLock.
+  vtkCriticalSection *TileLock;
+  int                 ImageTileSize;
+  int                 NumberOfTiles[2];
+  int                 NextTile;
+
+  // Returns the index of the next tile to cast, or -1 when all tiles have
+  // been taken.
+  int            GetNextTile();
+
   vtkRayCastImageDisplayHelper *ImageDisplayHelper;
   
   // This is how big the image would be if it covered the entire viewport